@@ -0,0 +1,90 @@
+/**
+ * @file monitor_latency.cpp
+ * @brief Measures how much earlier `NetlinkBackend` sees USB devices than `UdevBackend`.
+ *
+ * Both backends are attached to one `EventLoop`. Each event is stamped when
+ * its backend parses it; events are paired by action and devpath and the
+ * udev − kernel delta is reported once `N` pairs were collected.
+ *
+ * ## Usage
+ * ```
+ * make bench && ../bin/bench/monitor_latency 20
+ * # in another terminal, plug devices or replay them:
+ * sudo udevadm trigger --subsystem-match=usb --action=add
+ * ```
+ */
+#include "../include/EventLoop.hpp"
+#include "../include/UsbMonitor.hpp"
+#include "../include/UdevBackend.hpp"
+#include "../include/NetlinkBackend.hpp"
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    const size_t target = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10;
+
+    EventLoop loop;
+    UsbMonitor udev(std::make_unique<UdevBackend>());
+    UsbMonitor kernel(std::make_unique<NetlinkBackend>());
+
+    std::map<std::string, Clock::time_point> kernelSeen;
+    std::map<std::string, Clock::time_point> udevSeen;
+    std::vector<double> deltasUs;
+
+    auto match = [&](const std::string& key) {
+        auto k = kernelSeen.find(key);
+        auto u = udevSeen.find(key);
+        if (k == kernelSeen.end() || u == udevSeen.end()) return;
+
+        double us = std::chrono::duration<double, std::micro>(u->second - k->second).count();
+        deltasUs.push_back(us);
+        std::cout << "🔌 " << key << "  udev − kernel = " << us << " µs\n";
+        kernelSeen.erase(k);
+        udevSeen.erase(u);
+        if (deltasUs.size() >= target) loop.stop();
+    };
+
+    auto keyOf = [](const UsbEvent& e) {
+        return std::string(UsbEvent::actionName(e.action)) + " " + e.devpath;
+    };
+
+    bool ok = kernel.startMonitoring(loop, [&](const UsbEvent& e) {
+        kernelSeen[keyOf(e)] = e.receivedAt;
+        match(keyOf(e));
+    });
+    ok = udev.startMonitoring(loop, [&](const UsbEvent& e) {
+        udevSeen[keyOf(e)] = e.receivedAt;
+        match(keyOf(e));
+    }) && ok;
+    if (!ok) return 1;
+
+    loop.watchSignals({SIGINT, SIGTERM}, [&](int) { loop.stop(); });
+
+    std::cout << "⏳ Waiting for " << target << " USB add events (plug devices or run "
+              << "`sudo udevadm trigger --subsystem-match=usb --action=add`)\n";
+    loop.run();
+
+    if (deltasUs.empty()) {
+        std::cout << "No paired events.\n";
+        return 0;
+    }
+
+    std::sort(deltasUs.begin(), deltasUs.end());
+    double sum = 0;
+    for (double d : deltasUs) sum += d;
+
+    std::cout << "\n📊 " << deltasUs.size() << " events, udev delivery behind kernel (µs):\n"
+              << "   min    " << deltasUs.front() << "\n"
+              << "   median " << deltasUs[deltasUs.size() / 2] << "\n"
+              << "   mean   " << sum / deltasUs.size() << "\n"
+              << "   max    " << deltasUs.back() << "\n";
+    return 0;
+}
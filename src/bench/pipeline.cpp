@@ -0,0 +1,180 @@
+/**
+ * @file pipeline.cpp
+ * @brief Runs the whole daemon pipeline on synthetic USB events, without hardware.
+ *
+ * A `SyntheticBackend` replaces the udev monitor and feeds the real `App`:
+ * rate limiter, intake queue, coalescer, rules, `Notifier` and
+ * `SoundGenerator`. SDL runs on its `dummy` video and audio drivers by
+ * default, so the bench works on a headless box; PulseAudio is pointed at a
+ * socket that does not exist, so the streams of a desktop session are never
+ * muted. Configuration, caches and the stats file live in a temporary
+ * directory and use a short fade, so alerts do not dominate the run time.
+ *
+ * Once every event was generated and the queue drained, the pipeline gets
+ * `--drain-ms` to present its last alert, then the report lists intake
+ * throughput, queue and limiter counters, the `LatencyTracer` percentiles
+ * per stage, CPU time and peak RSS.
+ *
+ * ## Usage
+ * ```
+ * make bench && ../bin/bench/pipeline --rate 500 --burst 8 --events 5000 \
+ *     --mix 046d:c534*3,0781:5567,05ac:12a8
+ * ```
+ * Options: `--rate <events/s>` (0 floods), `--burst <n>`, `--events <n>`,
+ * `--mix <vid:pid[*weight],...>`, `--seed <n>`, `--video dummy|offscreen`,
+ * `--audio dummy|disk`, `--drain-ms <ms>`.
+ */
+#include "../include/App.hpp"
+#include "../include/SyntheticBackend.hpp"
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    struct Options {
+        SyntheticProfile profile;
+        std::string video = "dummy";
+        std::string audio = "dummy";
+        int drainMs = 1000;
+    };
+
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            std::string key = argv[i];
+            const char* value = argv[i + 1];
+            if (key == "--rate") options.profile.eventsPerSec = std::strtod(value, nullptr);
+            else if (key == "--burst") options.profile.burstSize = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+            else if (key == "--events") options.profile.totalEvents = std::strtoull(value, nullptr, 10);
+            else if (key == "--seed") options.profile.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else if (key == "--video") options.video = value;
+            else if (key == "--audio") options.audio = value;
+            else if (key == "--drain-ms") options.drainMs = std::atoi(value);
+            else if (key == "--mix") {
+                if (!SyntheticProfile::parseMix(value, options.profile.mix)) {
+                    std::cerr << "Bad device mix: " << value << "\n";
+                    return false;
+                }
+            } else {
+                std::cerr << "Unknown option: " << key << "\n";
+                return false;
+            }
+        }
+        return argc % 2 == 1;
+    }
+
+    // Everything the daemon reads or writes goes to a throwaway directory
+    std::string isolate(const Options& options) {
+        char dir[] = "/tmp/usb_moaner-bench-XXXXXX";
+        if (!mkdtemp(dir)) return "";
+        std::string root = dir;
+
+        setenv("XDG_CONFIG_HOME", root.c_str(), 1);
+        setenv("XDG_CACHE_HOME", root.c_str(), 1);
+        setenv("XDG_STATE_HOME", root.c_str(), 1);
+        setenv("XDG_RUNTIME_DIR", root.c_str(), 1);
+        setenv("PULSE_SERVER", ("unix:" + root + "/no-pulse").c_str(), 1);
+        setenv("SDL_VIDEODRIVER", options.video.c_str(), 1);
+        setenv("SDL_AUDIODRIVER", options.audio.c_str(), 1);
+        setenv("SDL_DISKAUDIOFILE", (root + "/audio.raw").c_str(), 1);
+
+        // Five 16 ms frames per alert
+        std::string configDir = root + "/usb_moaner";
+        mkdir(configDir.c_str(), 0755);
+        std::ofstream(configDir + "/config") << "fade_delay_ms = 0\nfade_speed = 51\nframe_delay_ms = 16\n";
+        return root;
+    }
+
+    double seconds(const timeval& tv) {
+        return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 2;
+
+    std::string root = isolate(options);
+    if (root.empty()) {
+        std::cerr << "Could not create a temporary directory\n";
+        return 1;
+    }
+
+    // The helper thread must not take the signals the presentation loop reads through signalfd
+    sigset_t mask;
+    sigemptyset(&mask);
+    for (int signo : {SIGTERM, SIGINT, SIGHUP, SIGUSR1}) sigaddset(&mask, signo);
+    pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+
+    auto backend = std::make_unique<SyntheticBackend>(options.profile);
+    SyntheticBackend* source = backend.get();
+    App app(std::move(backend));
+
+    // Stop once everything was generated, queued work was picked up and the last alert had time to show;
+    // give up as soon as run() returns on its own (setup failure), or the join below would never return
+    std::atomic<bool> runDone{false};
+    std::thread stopper([&]() {
+        while (!runDone && (!source->finished() || app.queueStats().depth > 0))
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto drainEnd = Clock::now() + std::chrono::milliseconds(options.drainMs);
+        while (!runDone && Clock::now() < drainEnd)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (!runDone) app.stop();
+    });
+
+    rusage before{};
+    getrusage(RUSAGE_SELF, &before);
+    auto start = Clock::now();
+    app.run();
+    double wallSec = std::chrono::duration<double>(Clock::now() - start).count();
+    runDone = true;
+    stopper.join();
+    if (!source->finished()) std::cerr << "⚠️ The pipeline stopped before the workload was generated\n";
+    rusage after{};
+    getrusage(RUSAGE_SELF, &after);
+
+    const SyntheticProfile& profile = options.profile;
+    double genSec = std::chrono::duration<double>(source->elapsed()).count();
+    QueueStats queue = app.queueStats();
+    RateLimiterStats limits = app.rateLimiterStats();
+    double userSec = seconds(after.ru_utime) - seconds(before.ru_utime);
+    double systemSec = seconds(after.ru_stime) - seconds(before.ru_stime);
+
+    std::printf("\n📊 Pipeline bench (%s video, %s audio)\n", options.video.c_str(), options.audio.c_str());
+    std::printf("   offered       %.0f events/s in bursts of %u (%zu device types)\n",
+                profile.eventsPerSec, std::max(profile.burstSize, 1u), std::max<size_t>(profile.mix.size(), 1));
+    std::printf("   generated     %llu events in %.3f s = %.0f events/s through intake\n",
+                static_cast<unsigned long long>(source->emitted()), genSec,
+                genSec > 0 ? static_cast<double>(source->emitted()) / genSec : 0.0);
+    std::printf("   queued        %llu (high-water %zu, dropped %llu)\n",
+                static_cast<unsigned long long>(queue.pushed), queue.highWater,
+                static_cast<unsigned long long>(queue.dropped));
+    std::printf("   rate-limited  %llu (device %llu, global %llu, quarantine %llu)\n",
+                static_cast<unsigned long long>(limits.suppressed()),
+                static_cast<unsigned long long>(limits.deviceLimited),
+                static_cast<unsigned long long>(limits.globalLimited),
+                static_cast<unsigned long long>(limits.quarantineDrops));
+    std::printf("   alerts        %llu\n",
+                static_cast<unsigned long long>(app.latency().histogram(TraceStage::PlugToPixel).count()));
+    std::printf("   cpu           %.3f s user + %.3f s system over %.3f s wall (%.1f%%)\n",
+                userSec, systemSec, wallSec, wallSec > 0 ? 100.0 * (userSec + systemSec) / wallSec : 0.0);
+    std::printf("   peak rss      %ld KiB\n\n", after.ru_maxrss);
+    std::fflush(stdout);
+    app.latency().dump(std::cout);
+    std::cout << "\n(scratch files in " << root << ")\n";
+    return 0;
+}
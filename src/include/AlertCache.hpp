@@ -0,0 +1,107 @@
+#pragma once
+#include "Config.hpp"
+#include "LoudnessNormalizer.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedSound
+ * @brief Read-only, memory-mapped samples of an `AlertCache` entry.
+ *
+ * Like `MappedImage`, the samples stay in the page cache and nothing is
+ * decoded or copied. Move-only; the mapping is released by the destructor.
+ */
+class MappedSound {
+public:
+    MappedSound() = default;
+    ~MappedSound();
+
+    MappedSound(MappedSound&& other) noexcept;
+    MappedSound& operator=(MappedSound&& other) noexcept;
+    MappedSound(const MappedSound&) = delete;
+    MappedSound& operator=(const MappedSound&) = delete;
+
+    /// @brief Whether an entry is mapped.
+    explicit operator bool() const { return mapping != nullptr; }
+
+    /// @brief First sample (read-only mapping).
+    void* samples() const { return sampleData; }
+
+    /// @brief Size of the samples in bytes.
+    size_t sampleBytes() const { return sampleLength; }
+
+    LoudnessNormalizer::Result loudness; ///< Normalization the stored samples went through.
+
+private:
+    friend class AlertCache;
+    void* mapping = nullptr;    ///< Whole file.
+    size_t length = 0;          ///< Mapping length.
+    void* sampleData = nullptr; ///< Samples inside `mapping`.
+    size_t sampleLength = 0;    ///< Bytes of samples.
+};
+
+/**
+ * @class AlertCache
+ * @brief On-disk store of alert sounds already decoded and loudness-normalized for a mixer format.
+ *
+ * The sibling of `BackgroundCache` for the sound: `AssetCache` decodes the
+ * MP3 at the mixer's output format and normalizes it once; this class keeps
+ * the result under `DisplayConfig::getCacheDir()`, so warm starts and idle
+ * wake-ups map ready-to-mix samples instead of decoding and analyzing again.
+ *
+ * ## File Format
+ * One raw file per entry, named after its key:
+ * `alert-<source hash>-<rate>-<format>-<channels>ch-<target hash>.pcm`. A
+ * 128-byte header (magic, key, loudness result) is followed by the
+ * interleaved samples exactly as SDL_mixer plays them.
+ *
+ * ## Design Notes
+ * - The key is a hash of the source file's **contents**, the mixer's sample
+ *   rate, format and channel count, and every `LoudnessTarget` value: a new
+ *   sound, another device format or a changed target each get their own
+ *   entry. The target values are also kept in the header and compared
+ *   exactly, the name only carries their hash.
+ * - Writes are atomic (temporary file and rename) and every failure only
+ *   costs a decode, as for `BackgroundCache`.
+ *
+ * Example usage:
+ * ```cpp
+ * AlertCache disk;
+ * AlertCache::Key key{hash, 44100, AUDIO_S16SYS, 2, LoudnessTarget{}};
+ * MappedSound sound = disk.open(key);
+ * if (!sound) disk.store(key, chunk->abuf, chunk->alen, result);
+ * ```
+ */
+class AlertCache {
+public:
+    /// Identity of one decoded and normalized alert.
+    struct Key {
+        uint64_t sourceHash = 0; ///< `BackgroundCache::hashFile()` of the source sound.
+        int frequency = 0;       ///< Mixer sample rate in Hz.
+        uint16_t format = 0;     ///< SDL audio format of the stored samples.
+        int channels = 0;        ///< Interleaved channels.
+        LoudnessTarget target;   ///< Level the samples were normalized to.
+    };
+
+    /// @brief Cache rooted at `dir` (created on the first `store()`).
+    explicit AlertCache(std::string dir = DisplayConfig::getCacheDir());
+
+    /// @brief Maps the entry for `key`; an empty `MappedSound` on a miss or a corrupt entry.
+    MappedSound open(const Key& key) const;
+
+    /**
+     * @brief Writes an entry atomically.
+     * @param samples  Normalized samples at the key's format.
+     * @param bytes    Size of `samples` in bytes.
+     * @param loudness Normalization that produced them.
+     * @return `true` if the entry was stored.
+     */
+    bool store(const Key& key, const void* samples, size_t bytes, const LoudnessNormalizer::Result& loudness) const;
+
+    /// @brief File path of the entry for `key`.
+    std::string pathFor(const Key& key) const;
+
+private:
+    std::string directory; ///< Cache directory.
+};
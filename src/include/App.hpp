@@ -1,26 +1,263 @@
 #pragma once
 #include "UsbMonitor.hpp"
 #include "Notifier.hpp"
+#include "RingBuffer.hpp"
+#include "UsbEvent.hpp"
+#include "EventCoalescer.hpp"
+#include "RateLimiter.hpp"
+#include "ConfigStore.hpp"
+#include "ConfigWatcher.hpp"
+#include "EventLoop.hpp"
+#include "Coroutine.hpp"
+#include "LatencyTracer.hpp"
+#include "SleepWatcher.hpp"
+#include "ControlServer.hpp"
+#include "IdleTracker.hpp"
+#include "Config.hpp"
+#include <atomic>
+#include <string>
+#include <string_view>
 
 /**
  * @class App
  * @brief Core application controller coordinating the USB monitor and notifier.
  *
- * The `App` class represents the main runtime logic of the program.  
+ * The `App` class represents the main runtime logic of the program.
  * It wires together the hardware event listener (`UsbMonitor`) and the
- * visual/audio alert system (`Notifier`) into a simple reactive loop.
+ * visual/audio alert system (`Notifier`) into a simple reactive pipeline.
  *
  * ## Responsibilities
  * - Instantiate and manage the `UsbMonitor` and `Notifier` components.
  * - Listen for USB device plug events and trigger the notification display.
+ * - Apply per-device rules (`RuleEngine`): ignored devices are dropped at
+ *   intake, silent ones only logged, others may pick their own assets and fade.
+ * - Load the runtime configuration (`RuntimeConfig`) and reload it whenever
+ *   the config or rules file changes (inotify) or on SIGHUP.
+ * - Alert for devices plugged while the daemon was stopped or the machine
+ *   was suspended (`UsbMonitor::trackDevices()`), rescanning on resume
+ *   (`SleepWatcher`).
+ * - Journal every USB event, removals included, to
+ *   `JournalConfig::getJournalPath()` (`EventJournal`).
+ * - Trace the latency of every stage from the kernel event to the first
+ *   pixel and the first audio buffer (`LatencyTracer`); SIGUSR1 prints the
+ *   histograms and rewrites `TraceConfig::getStatsPath()`.
+ * - Answer the local control socket (`ControlServer`): live stats, test
+ *   alerts, muting and reloads without signals or real devices.
+ * - Release the presentation engine after `idle_release_s` without alerts
+ *   and prewarm it on the next event (see Idle Mode).
+ * - Shut down cleanly on SIGTERM/SIGINT.
  * - Serve as the single entry point for the application (`main.cpp` simply calls `app.run()`).
  *
+ * ## Threading
+ * Each thread runs one `EventLoop` (epoll reactor) and sleeps in `epoll_wait()`
+ * while nothing happens; no timer is armed while idle.
+ * - **Intake thread**: its loop watches the udev socket. Events are parsed,
+ *   passed through the `RateLimiter` (storm protection) and the survivors are
+ *   pushed into a bounded lock-free SPSC `RingBuffer`, so the udev socket is
+ *   always drained promptly, even during a long fade. It also owns the
+ *   system bus connection of the `SleepWatcher`, so resume rescans run there
+ *   and their events take the same path as live ones.
+ * - **Presentation thread** (the main thread, as SDL video requires): its loop
+ *   watches the queue's `eventfd`, a `signalfd` and a debounce `timerfd`
+ *   closing the `EventCoalescer` window, so bursts are merged and rendering
+ *   never blocks the loop. Each alert is a coroutine on this loop (see
+ *   Alert Lifecycle), not a thread.
+ * - **Control thread**: its loop serves the control socket, so no number of
+ *   clients can delay the intake or presentation loops. Stats and mute are
+ *   answered there from atomics; injected events and reloads are handed to
+ *   the presentation thread through a second SPSC `RingBuffer` and `eventfd`.
+ *   Injected events skip the intake rate limiter but go through the rules,
+ *   the coalescer and the notifier like real ones.
+ * - A full queue drops the newest event and counts it; queue depth, high-water
+ *   mark and drops are logged after every notification.
+ * - Configuration is read through a `ConfigStore`: both threads pin the
+ *   current snapshot per event without locks, while the presentation loop
+ *   builds and publishes new snapshots. Queued events are untouched by a
+ *   reload and simply use the new settings when they are presented.
+ *
+ * ## Alert Lifecycle
+ * An alert is written as one straight-line coroutine (`fadeAlert()`, see
+ * `Coroutine.hpp`) rather than a timer callback plus state flags:
+ * `Notifier::begin()` shows the overlay and starts the sound, the coroutine
+ * then holds full opacity and fades by `co_await`ing its own frame
+ * `timerfd`, and once the screen is clear it serves the next batch. Restoring
+ * the other audio streams follows the sound's end through `audioFd()`,
+ * independently, so the sounds of successive alerts may overlap.
+ * - A newer batch preempts the alert on screen: `alertCancel` resumes its
+ *   coroutine with a cancelled result, it returns and frees its timer, and the
+ *   new alert takes the overlay over without hiding it in between.
+ * - Shutdown cancels the same way before the engine is released, so no
+ *   coroutine frame outlives the loop.
+ * - Silenced and muted batches leave the alert on screen alone.
+ *
+ * ## Latency Tracing
+ * Each `UsbEvent` carries its own timestamps (kernel, received, dequeued);
+ * the alert's show, first-present and first-audio-buffer times come from the
+ * `Notifier`. A batch is traced through its first event. Stages are recorded
+ * where their end is observed, into lock-free histograms, so the intake and
+ * presentation threads never contend and tracing stays on in production.
+ *
+ * ## Idle Mode
+ * Alerts are rare, so keeping SDL, the overlay windows, the audio device, the
+ * PulseAudio connection and the decoded assets resident all day is waste.
+ * - An idle timer on the presentation loop is re-armed after every alert;
+ *   when it fires with nothing on screen, playing or pending,
+ *   `Notifier::shutdown()` releases the whole engine and `malloc_trim()`
+ *   hands the freed heap back to the kernel.
+ * - The first event dequeued afterwards prewarms the engine right away, at
+ *   the start of the coalescing window, so the rebuild overlaps the window
+ *   instead of following it; the background is mapped back from its disk
+ *   cache rather than decoded.
+ * - Only the SDL video half of the rebuild (windows, renderers, textures)
+ *   runs on the presentation loop, since SDL video belongs to the main
+ *   thread. The audio device, the PulseAudio connection and the alert sounds
+ *   are prepared on a helper thread (`Notifier::startInit()`), so signals,
+ *   control commands and audio completions keep being served meanwhile. Its
+ *   completion is one more eventfd on the loop; a batch whose window closes
+ *   before that waits for it and is shown right after.
+ * - `IdleTracker` accounts time, loop wakeups and RSS of both states; the
+ *   transitions are logged and the totals printed with the latency report.
+ *
  * ## Dependencies
  * - `UsbMonitor` (libudev backend)
  * - `Notifier` (SDL2-based display and sound)
+ * - `EventLoop` (epoll, eventfd, timerfd, signalfd)
  */
 class App {
 public:
-    /// @brief Starts the application event loop.
+    /// Maximum number of events buffered between intake and presentation.
+    static constexpr size_t QUEUE_CAPACITY = 256;
+
+    /// `ConfigStore` reader slot of the intake thread.
+    static constexpr size_t INTAKE_READER = 0;
+
+    /// `ConfigStore` reader slot of the presentation thread.
+    static constexpr size_t PRESENT_READER = 1;
+
+    /**
+     * @brief Builds the pipeline.
+     * @param backend USB event source; the one selected by `MonitorConfig` when `nullptr`.
+     */
+    explicit App(std::unique_ptr<MonitorBackend> backend = nullptr);
+
+    /// @brief Releases the wakeup descriptors.
+    ~App();
+
+    App(const App&) = delete;
+    App& operator=(const App&) = delete;
+
+    /// @brief Runs the daemon until SIGTERM/SIGINT or `stop()`.
     void run();
+
+    /// @brief Makes `run()` return; safe from any thread.
+    void stop();
+
+    /// @brief Counters of the intake → presentation queue.
+    QueueStats queueStats() const { return queue.stats(); }
+
+    /// @brief Counters and state of the storm protection.
+    RateLimiterStats rateLimiterStats() const { return limiter.stats(); }
+
+    /// @brief Per-stage latency histograms.
+    const LatencyTracer& latency() const { return tracer; }
+
+private:
+    UsbMonitor monitor;                          ///< udev event source.
+    SleepWatcher sleepWatcher;                   ///< Resume notifications (intake thread).
+    Notifier notifier;                           ///< Presentation engine.
+    RateLimiter limiter;                         ///< Per-device and global storm protection.
+    ConfigStore config;                          ///< Current settings and device rules.
+    ConfigWatcher configWatcher;                 ///< inotify on the config directory.
+    RingBuffer<UsbEvent, QUEUE_CAPACITY> queue;  ///< Intake → presentation hand-off.
+    int wakeFd = -1;                             ///< eventfd signalled on every push.
+    EventCoalescer coalescer;                    ///< Merges bursts into one alert.
+    char message[1024] = {};                     ///< Batch summary handed to the notifier.
+    LatencyTracer tracer;                        ///< Plug → alert stage histograms.
+    std::atomic<int64_t> mutedUntil{0};          ///< `system_clock` ns until which alerts are muted.
+    IdleTracker idle;                            ///< Active / idle accounting (presentation thread).
+    std::atomic<bool> idleNow{false};            ///< Engine released, for the control thread.
+    std::chrono::steady_clock::time_point alertOrigin; ///< Kernel time of the alert awaiting its sound.
+    std::chrono::steady_clock::time_point alertShownAt; ///< Show time of that alert.
+    bool awaitingAudio = false;                  ///< Its first audio buffer is still to be traced.
+    std::chrono::steady_clock::time_point prewarmStartedAt; ///< Start of the rebuild in progress.
+    std::chrono::steady_clock::duration prewarmOnLoop{};     ///< Part of it that ran on the loop.
+
+    EventLoop intakeLoop;                        ///< Runs on the intake thread.
+    EventLoop presentLoop;                       ///< Runs on the main thread.
+    EventLoop controlLoop;                       ///< Runs on the control thread.
+    int coalesceTimer = -1;                      ///< Fires when the coalescing window closes.
+    int idleTimer = -1;                          ///< Fires after the idle release delay.
+    CancelSource alertCancel;                    ///< Cancels the alert coroutine on screen.
+
+    /// Request handed from the control thread to the presentation thread.
+    struct ControlCommand {
+        enum class Kind { Inject, Reload } kind = Kind::Inject;
+        UsbEvent event;                          ///< Device to alert for (`Inject`).
+    };
+    ControlServer control;                       ///< Control socket (control thread).
+    RingBuffer<ControlCommand, ControlConfig::COMMAND_QUEUE_CAPACITY> commands; ///< Control → presentation hand-off.
+    int commandFd = -1;                          ///< eventfd signalled on every command.
+
+    /// @brief Intake side: rate-limit, enqueue an event and wake the presentation thread.
+    void enqueue(const UsbEvent& event);
+
+    /// @brief Presentation side: moves every queued event into the coalescer.
+    void drainQueue();
+
+    /// @brief Presentation side: notifies the pending batch now or arms the debounce timer.
+    void schedule();
+
+    /// @brief Presentation side: shows the collected batch, replacing the alert on screen.
+    void notifyBatch();
+
+    /**
+     * @brief Presentation side: fades the alert shown by `begin()`, frame by frame.
+     *
+     * Runs on `presentLoop` until the fade ends, then serves the events that
+     * piled up meanwhile. When `cancel` fires it returns at once and leaves
+     * the overlay to the canceller.
+     */
+    Task fadeAlert(std::chrono::milliseconds hold, CancelToken cancel);
+
+    /// @brief Presentation side: rebuilds and publishes the configuration snapshot; `true` if it rebuilt the asset caches.
+    bool reloadConfig();
+
+    /// @brief Presentation side: decodes the assets the current snapshot needs; `true` if the caches were rebuilt.
+    bool applyAssets();
+
+    /// @brief Presentation side: retires finished sounds and traces the first audio buffer.
+    void onAudio();
+
+    /// @brief Presentation side: restarts the idle countdown (or stops it when disabled).
+    void armIdle();
+
+    /// @brief Presentation side: releases the engine if nothing is going on, else waits again.
+    void releaseIdle();
+
+    /// @brief Presentation side: starts rebuilding the engine after idle mode.
+    void prewarm();
+
+    /// @brief Presentation side: finishes the rebuild once its helper thread is done.
+    void finishPrewarm();
+
+    /// @brief Wakeups of all event loops.
+    uint64_t wakeups() const;
+
+    /// @brief Presentation side: prints the latency histograms and rewrites the stats file.
+    void reportLatency();
+
+    /// @brief Presentation side: runs the commands queued by the control thread.
+    void drainCommands();
+
+    /// @brief Control side: answers one control socket request.
+    void onControl(std::string_view request, std::string& reply);
+
+    /// @brief Control side: queues a command for the presentation thread.
+    bool submit(const ControlCommand& command);
+
+    /// @brief Whether alerts are muted right now.
+    bool muted() const;
+
+    /// @brief Presentation side: handles SIGTERM/SIGINT/SIGHUP/SIGUSR1.
+    void onSignal(int signo);
 };
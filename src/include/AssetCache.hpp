@@ -0,0 +1,185 @@
+#pragma once
+#include "AlertCache.hpp"
+#include "BackgroundCache.hpp"
+#include "LoudnessNormalizer.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+struct SDL_Renderer;
+struct SDL_Surface;
+struct SDL_Texture;
+struct Mix_Chunk;
+
+/**
+ * @struct AssetFootprint
+ * @brief Memory held by the decoded assets, in bytes.
+ */
+struct AssetFootprint {
+    size_t surfaceBytes = 0; ///< Decoded background pixels kept in system memory.
+    size_t textureBytes = 0; ///< Estimated GPU memory of the background texture.
+    size_t pcmBytes = 0;     ///< Decoded alert samples at the mixer output format.
+
+    /// @brief Sum of all categories.
+    size_t total() const { return surfaceBytes + textureBytes + pcmBytes; }
+};
+
+/**
+ * @struct AssetPaths
+ * @brief Files an `AssetCache` decodes; an empty path selects the `Config.hpp` default.
+ */
+struct AssetPaths {
+    std::string background; ///< Overlay image.
+    std::string sound;      ///< Alert sound.
+};
+
+/**
+ * @class AssetCache
+ * @brief Decodes the background image and alert sound once and serves them from memory.
+ *
+ * Before the cache existed every notification called `IMG_Load()` and
+ * `Mix_LoadMUS()` and stat'ed both files again, putting PNG and MP3
+ * decoding on the hot path. The cache moves all of that to startup:
+ * an alert only plays a ready `Mix_Chunk` and copies a ready texture.
+ *
+ * ## Responsibilities
+ * - Resolve asset paths (`Config.hpp`) and check their existence once.
+ * - Resample `background.png` once to each renderer's output size (one per
+ *   display), in that renderer's preferred pixel format, and upload it as a
+ *   GPU texture.
+ * - Persist the resampled background (`BackgroundCache`), so later starts map
+ *   it from disk instead of decoding the PNG.
+ * - Decode `Effect.mp3` into PCM (`Mix_Chunk`) at the mixer's output sample rate
+ *   and normalize it in place to `AudioConfig::TARGET_LOUDNESS_LUFS`
+ *   (`LoudnessNormalizer`), keeping the measurement next to the samples.
+ * - Persist the normalized samples (`AlertCache`), so later starts map them
+ *   from disk instead of decoding and analyzing the MP3.
+ * - Report the memory footprint of everything it holds.
+ * - Reload everything from disk on demand (e.g. after an asset was replaced).
+ *
+ * ## Design Notes
+ * - The audio device must already be open (`Mix_OpenAudio`) when `load()` runs,
+ *   otherwise SDL_mixer cannot convert the samples to the output format; the
+ *   sound is then simply skipped and can be picked up by a later `reload()`.
+ * - The converted surface is kept next to the texture so the texture can be
+ *   re-uploaded without decoding the PNG again. For a cached background it
+ *   points straight into the read-only mapping of the cache file.
+ * - Resampling (`ImageScaler`, a tent filter on SSE2/AVX2) happens once per
+ *   image and resolution, so each frame is a 1:1 copy instead of a GPU
+ *   rescale of the full-size image. With `DisplayConfig::PRESCALE_BACKGROUND`
+ *   off, or without a renderer, the image is kept at its own size.
+ * - `load()` is `loadImages()` followed by `loadSound()`. The two halves may
+ *   run on different threads: the images need the renderers' (video)
+ *   thread, the sound only an open mixer, so the daemon decodes it off its
+ *   event loop (see `Notifier::startInit()`).
+ * - With several displays the PNG is decoded **once**; the per-display
+ *   resamples run concurrently on worker threads (displays sharing a size and
+ *   format share one), and only the texture uploads stay on the caller's
+ *   thread, which owns the renderers.
+ * - Missing assets are not fatal: `background()` / `alert()` return `nullptr`
+ *   and callers fall back (solid color, silence).
+ *
+ * ## Example
+ * ```cpp
+ * AssetCache assets;
+ * assets.load({renderer});
+ * SDL_RenderCopy(renderer, assets.background(0), nullptr, nullptr);
+ * Mix_PlayChannel(-1, assets.alert(), 0);
+ * ```
+ */
+class AssetCache {
+public:
+    AssetCache() = default;
+
+    /// @brief Cache for custom files (e.g. a device rule's asset pair).
+    explicit AssetCache(AssetPaths paths) : paths(std::move(paths)) {}
+
+    /// @brief Frees every decoded asset.
+    ~AssetCache();
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    /**
+     * @brief Decodes both assets and uploads a background texture to every renderer.
+     * @param renderers One renderer per screen; `background(i)` serves `renderers[i]`.
+     * @return `true` if at least one asset is available.
+     */
+    bool load(const std::vector<SDL_Renderer*>& renderers);
+
+    /**
+     * @brief Decodes the background and uploads a texture to every renderer.
+     *
+     * Must run on the thread owning the renderers.
+     *
+     * @param renderers One renderer per screen; `background(i)` serves `renderers[i]`.
+     * @return `true` if a texture is available on at least one screen.
+     */
+    bool loadImages(const std::vector<SDL_Renderer*>& renderers);
+
+    /**
+     * @brief Decodes and normalizes the alert sound.
+     *
+     * Touches no video state, so it may run on any thread once the mixer is
+     * open, as long as nothing else uses this cache meanwhile.
+     *
+     * @return `true` if the sound is available.
+     */
+    bool loadSound();
+
+    /**
+     * @brief Drops the cached assets and decodes them again from disk.
+     * @return `true` if at least one asset is available afterwards.
+     */
+    bool reload();
+
+    /// @brief Frees every decoded asset (the renderer bindings are kept).
+    void release();
+
+    /// @brief Background texture of screen `screen`, ready for `SDL_RenderCopy`, or `nullptr`.
+    SDL_Texture* background(size_t screen = 0) const {
+        return screen < backgrounds.size() ? backgrounds[screen].texture : nullptr;
+    }
+
+    /// @brief Decoded alert sound ready for `Mix_PlayChannel`, or `nullptr`.
+    Mix_Chunk* alert() const { return chunk; }
+
+    /// @brief Loudness measured and gain applied when the alert was decoded; `nullptr` if not normalized.
+    const LoudnessNormalizer::Result* alertLoudness() const { return normalized ? &loudness : nullptr; }
+
+    /// @brief Memory currently held by the cache; queries the textures, so only on the renderers' thread.
+    AssetFootprint footprint() const;
+
+    /// @brief Logs `footprint()`; `load()` does so itself, callers of the two halves once both are done.
+    void logFootprint() const;
+
+private:
+    /// Background prepared for one screen.
+    struct Background {
+        BackgroundCache::Key key;       ///< Target size and format (and source hash).
+        SDL_Surface* surface = nullptr; ///< Pixels in the renderer's format.
+        MappedImage mapped;             ///< Cache file backing `surface`, if any.
+        SDL_Texture* texture = nullptr; ///< GPU copy of `surface`.
+    };
+
+    AssetPaths paths;                      ///< Custom files; empty entries use the defaults.
+    std::vector<SDL_Renderer*> renderers;  ///< One per screen, for `reload()`.
+    std::vector<Background> backgrounds;   ///< Parallel to `renderers`.
+    Mix_Chunk* chunk = nullptr;            ///< Decoded alert PCM, normalized.
+    MappedSound mappedAlert;               ///< Cache file backing `chunk`, if any.
+    LoudnessNormalizer::Result loudness;   ///< Normalization of `chunk`.
+    bool normalized = false;               ///< `loudness` describes `chunk`.
+
+    /// @brief Prepares the background of every screen and uploads the textures.
+    void loadBackgrounds(const std::string& path);
+
+    /// @brief Decodes the alert sound at the mixer output format and normalizes its loudness.
+    void loadAlert(const std::string& path);
+
+    /// @brief Frees the backgrounds (textures, surfaces, mappings).
+    void releaseImages();
+
+    /// @brief Frees the alert sound.
+    void releaseSound();
+};
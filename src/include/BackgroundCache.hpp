@@ -0,0 +1,112 @@
+#pragma once
+#include "Config.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedImage
+ * @brief Read-only, memory-mapped pixels of a `BackgroundCache` entry.
+ *
+ * The pixels stay in the page cache and are shared with every process
+ * mapping the same file; nothing is copied or decoded. Move-only; the
+ * mapping is released by the destructor.
+ */
+class MappedImage {
+public:
+    MappedImage() = default;
+    ~MappedImage();
+
+    MappedImage(MappedImage&& other) noexcept;
+    MappedImage& operator=(MappedImage&& other) noexcept;
+    MappedImage(const MappedImage&) = delete;
+    MappedImage& operator=(const MappedImage&) = delete;
+
+    /// @brief Whether an entry is mapped.
+    explicit operator bool() const { return mapping != nullptr; }
+
+    /// @brief First pixel row (read-only mapping).
+    void* pixels() const { return pixelData; }
+
+    int width = 0;       ///< Width in pixels.
+    int height = 0;      ///< Height in pixels.
+    size_t pitch = 0;    ///< Bytes per row.
+    uint32_t format = 0; ///< SDL pixel format.
+
+    /// @brief Size of the mapping in bytes.
+    size_t bytes() const { return length; }
+
+private:
+    friend class BackgroundCache;
+    void* mapping = nullptr;   ///< Whole file.
+    size_t length = 0;         ///< Mapping length.
+    void* pixelData = nullptr; ///< Pixels inside `mapping`.
+};
+
+/**
+ * @class BackgroundCache
+ * @brief On-disk store of backgrounds already resampled to a display's size and pixel format.
+ *
+ * `AssetCache` resamples the background once per display resolution; this
+ * class persists the result under `DisplayConfig::getCacheDir()`, so cold
+ * daemon starts map ready-to-upload pixels instead of decoding the PNG.
+ *
+ * ## File Format
+ * One raw file per entry, named after its key:
+ * `bg-<source hash>-<width>x<height>-<format>.raw`. A 64-byte header (magic,
+ * key, pitch) is followed by `pitch * height` bytes of pixels, so the file
+ * can be mapped and handed to SDL as is.
+ *
+ * ## Design Notes
+ * - The key is a hash of the source file's **contents**, the target size and
+ *   the SDL pixel format: replacing the image, changing the resolution or
+ *   running on a GPU with another native format each get their own entry,
+ *   and stale entries are never served.
+ * - Entries are written to a temporary file and renamed into place, so a
+ *   crash or a second daemon never exposes a half-written file.
+ * - Every failure (read-only home, full disk, corrupt entry) only costs a
+ *   PNG decode; the directory is disposable.
+ *
+ * Example usage:
+ * ```cpp
+ * BackgroundCache disk;
+ * BackgroundCache::Key key{hash, 1920, 1080, SDL_PIXELFORMAT_ARGB8888};
+ * MappedImage image = disk.open(key);
+ * if (!image) disk.store(key, pixels, pitch);
+ * ```
+ */
+class BackgroundCache {
+public:
+    /// Identity of one pre-scaled background.
+    struct Key {
+        uint64_t sourceHash = 0; ///< `hashFile()` of the source image.
+        int width = 0;           ///< Target width.
+        int height = 0;          ///< Target height.
+        uint32_t format = 0;     ///< SDL pixel format of the stored pixels.
+    };
+
+    /// @brief Cache rooted at `dir` (created on the first `store()`).
+    explicit BackgroundCache(std::string dir = DisplayConfig::getCacheDir());
+
+    /**
+     * @brief Hashes a file's contents (64-bit, not cryptographic).
+     * @return `false` if the file cannot be read.
+     */
+    static bool hashFile(const std::string& path, uint64_t& hash);
+
+    /// @brief Maps the entry for `key`; an empty `MappedImage` on a miss or a corrupt entry.
+    MappedImage open(const Key& key) const;
+
+    /**
+     * @brief Writes an entry atomically.
+     * @param pixels `key.height` rows of `pitch` bytes.
+     * @return `true` if the entry was stored.
+     */
+    bool store(const Key& key, const void* pixels, size_t pitch) const;
+
+    /// @brief File path of the entry for `key`.
+    std::string pathFor(const Key& key) const;
+
+private:
+    std::string directory; ///< Cache directory.
+};
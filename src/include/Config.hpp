@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
 #include <filesystem>
+#include <cstdlib>
+#include <unistd.h>
 
 /**
  * @file Config.hpp
@@ -17,9 +19,16 @@
  * - Avoid magic numbers scattered across code by grouping configuration logically.
  *
  * ## Namespaces
- * - **AudioConfig**: audio volume and sound path management.
+ * - **AudioConfig**: audio volume, loudness normalization and sound path management.
  * - **FadeConfig**: fade animation timing parameters.
  * - **DisplayConfig**: background image resource handling.
+ * - **PipelineConfig**: event pipeline tuning between monitor and notifier.
+ * - **IdleConfig**: release of the presentation engine between alerts.
+ * - **RateLimitConfig**: storm protection for flapping devices.
+ * - **MonitorConfig**: choice and tuning of the USB event source.
+ * - **JournalConfig**: size and location of the USB event journal.
+ * - **ControlConfig**: the local control socket.
+ * - **UserConfig**: location of the hot-reloaded user configuration and rules.
  *
  * ## Dependencies
  * - Requires C++17 `<filesystem>` for path existence checks.
@@ -33,8 +42,24 @@ namespace fs = std::filesystem;
  * @brief Configuration values and helpers for sound playback.
  */
 namespace AudioConfig {
-    /// Default playback volume (0–100).
+    /// Default alert volume (0–100), applied to the alert's voice only.
     constexpr int VOLUME_PERCENT = 100;
+    /// Bring every alert sound to `TARGET_LOUDNESS_LUFS` when it is decoded.
+    constexpr bool NORMALIZE_LOUDNESS = true;
+    /// Integrated loudness of normalized alerts (LUFS, ITU-R BS.1770).
+    constexpr double TARGET_LOUDNESS_LUFS = -14.0;
+    /// Highest sample peak of a normalized alert (dBFS).
+    constexpr double PEAK_CEILING_DBFS = -1.0;
+    /// Largest boost given to quiet sounds (dB).
+    constexpr double MAX_GAIN_DB = 12.0;
+    /// Largest overshoot of the ceiling clipped away instead of lowering the gain (dB).
+    constexpr double MAX_LIMITING_DB = 3.0;
+    /// Mixer buffer in sample frames; smaller means lower output latency (~12 ms at 44.1 kHz).
+    constexpr int BUFFER_SAMPLES = 512;
+    /// Mixer channels available to overlapping alerts.
+    constexpr int VOICES = 4;
+    /// Priority of alerts without a rule-defined one (higher wins the voice pool).
+    constexpr int DEFAULT_PRIORITY = 0;
 
     /**
      * @brief Resolve the full path to the alert sound file.
@@ -60,6 +85,8 @@ namespace FadeConfig {
     constexpr int FADE_SPEED = 5;
     /// Delay between frames in milliseconds (~16ms = 60 FPS).
     constexpr int FRAME_DELAY_MS = 16;
+    /// Synchronize presents to the display refresh when the renderer supports it.
+    constexpr bool VSYNC = true;
 }
 
 /**
@@ -75,3 +102,204 @@ namespace DisplayConfig {
      */
     inline std::string getBackgroundPath() {
         std::string installPath = "/opt/usb_moaner/background.png";
+        if (fs::exists(installPath)) return installPath;
+        return "../resource/Layout/background.png";
+    }
+
+    /// Resample the background to the display resolution once, instead of scaling it on every frame.
+    constexpr bool PRESCALE_BACKGROUND = true;
+    /// Draw the triggering devices (action, VID:PID, node, batch size) over the background.
+    constexpr bool SHOW_EVENT_DETAILS = true;
+    /// Text rows fitting the screen height; sets the integer scale of the 8x16 font.
+    constexpr int TEXT_ROWS = 24;
+    /// Opacity of the box behind the text at full overlay opacity (0–255).
+    constexpr int TEXT_BACKDROP_ALPHA = 160;
+
+    /**
+     * @brief Resolve the directory of the pre-scaled background and normalized alert caches.
+     *
+     * `$XDG_CACHE_HOME/usb_moaner`, falling back to `~/.cache/usb_moaner`.
+     * Its files are disposable: deleting them only costs one PNG or MP3 decode.
+     */
+    inline std::string getCacheDir() {
+        if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg)
+            return std::string(xdg) + "/usb_moaner";
+        if (const char* home = std::getenv("HOME"); home && *home)
+            return std::string(home) + "/.cache/usb_moaner";
+        return ".";
+    }
+}
+
+/**
+ * @namespace PipelineConfig
+ * @brief Tuning of the event pipeline between `UsbMonitor` and `Notifier`.
+ */
+namespace PipelineConfig {
+    /// Events arriving within this many milliseconds of the first one share one notification (0 = off).
+    constexpr int COALESCE_WINDOW_MS = 250;
+    /// Maximum number of devices merged into a single notification.
+    constexpr int MAX_BATCH_SIZE = 64;
+}
+
+/**
+ * @namespace IdleConfig
+ * @brief When the daemon releases its presentation engine between alerts.
+ */
+namespace IdleConfig {
+    /// Quiet time (s) after which windows, audio device and decoded assets are released (0 = never).
+    constexpr int RELEASE_AFTER_S = 300;
+}
+
+/**
+ * @namespace RateLimitConfig
+ * @brief Token-bucket limits applied to USB events before they are queued.
+ */
+namespace RateLimitConfig {
+    /// Alerts a single device (vendor:product:devpath) may trigger back to back.
+    constexpr double DEVICE_BURST = 3.0;
+    /// Tokens regained per second by a single device.
+    constexpr double DEVICE_REFILL_PER_SEC = 0.2;
+    /// Alerts all devices together may trigger back to back.
+    constexpr double GLOBAL_BURST = 20.0;
+    /// Tokens regained per second by the global bucket.
+    constexpr double GLOBAL_REFILL_PER_SEC = 2.0;
+    /// Rejected events (without an accepted one in between) before a device is quarantined.
+    constexpr int QUARANTINE_AFTER = 5;
+    /// How long a flapping device stays quarantined, in milliseconds.
+    constexpr int QUARANTINE_MS = 60000;
+}
+
+/**
+ * @namespace MonitorConfig
+ * @brief Selection and tuning of the `UsbMonitor` event source.
+ */
+namespace MonitorConfig {
+    /// Read raw kernel uevents (`NetlinkBackend`) instead of udevd's processed events (`UdevBackend`).
+    constexpr bool USE_KERNEL_UEVENTS = false;
+    /// Socket receive buffer, in bytes, so event storms are not dropped by the kernel.
+    constexpr int RECEIVE_BUFFER_BYTES = 1 << 20;
+    /// Alert for devices plugged while the daemon was stopped or the machine was asleep.
+    constexpr bool RECONCILE_DEVICES = true;
+    /// After a rescan, live events for the devices it reported are dropped for this long (ms).
+    constexpr int RECONCILE_DEDUPE_MS = 5000;
+
+    /**
+     * @brief Resolve the file holding the last known set of USB devices.
+     *
+     * `$XDG_STATE_HOME/usb_moaner/devices`, falling back to
+     * `~/.local/state/usb_moaner/devices`.
+     */
+    inline std::string getSnapshotPath() {
+        if (const char* xdg = std::getenv("XDG_STATE_HOME"); xdg && *xdg)
+            return std::string(xdg) + "/usb_moaner/devices";
+        if (const char* home = std::getenv("HOME"); home && *home)
+            return std::string(home) + "/.local/state/usb_moaner/devices";
+        return "devices";
+    }
+}
+
+/**
+ * @namespace JournalConfig
+ * @brief The audit journal of every USB event (`EventJournal`).
+ */
+namespace JournalConfig {
+    /// Record every USB event, removals included, in the journal.
+    constexpr bool ENABLED = true;
+    /// Events kept before the oldest are overwritten (32 bytes each: 2 MiB).
+    constexpr unsigned CAPACITY = 1 << 16;
+
+    /**
+     * @brief Resolve the journal file.
+     *
+     * `$XDG_STATE_HOME/usb_moaner/journal`, falling back to
+     * `~/.local/state/usb_moaner/journal`.
+     */
+    inline std::string getJournalPath() {
+        if (const char* xdg = std::getenv("XDG_STATE_HOME"); xdg && *xdg)
+            return std::string(xdg) + "/usb_moaner/journal";
+        if (const char* home = std::getenv("HOME"); home && *home)
+            return std::string(home) + "/.local/state/usb_moaner/journal";
+        return "journal";
+    }
+}
+
+/**
+ * @namespace ControlConfig
+ * @brief The local control socket (`ControlServer`).
+ */
+namespace ControlConfig {
+    /// Serve the control socket.
+    constexpr bool ENABLED = true;
+    /// Connections kept at once; further ones are closed on accept.
+    constexpr int MAX_CLIENTS = 16;
+    /// Longest request accepted, in bytes.
+    constexpr size_t MAX_REQUEST_BYTES = 256;
+    /// Injected events and reload requests waiting for the presentation thread.
+    constexpr size_t COMMAND_QUEUE_CAPACITY = 16;
+    /// Longest mute accepted, in minutes.
+    constexpr int MAX_MUTE_MINUTES = 24 * 60;
+
+    /**
+     * @brief Resolve the socket path.
+     *
+     * `$XDG_RUNTIME_DIR/usb_moaner.sock`, falling back to `/tmp/usb_moaner-<uid>.sock`.
+     */
+    inline std::string getSocketPath() {
+        if (const char* runtime = std::getenv("XDG_RUNTIME_DIR"); runtime && *runtime)
+            return std::string(runtime) + "/usb_moaner.sock";
+        return "/tmp/usb_moaner-" + std::to_string(getuid()) + ".sock";
+    }
+}
+
+/**
+ * @namespace TraceConfig
+ * @brief Where the plug → alert latency histograms (`LatencyTracer`) are reported.
+ */
+namespace TraceConfig {
+    /**
+     * @brief Resolve the stats file rewritten on SIGUSR1 and at shutdown.
+     *
+     * `$XDG_RUNTIME_DIR/usb_moaner-latency`, falling back to `/tmp`.
+     */
+    inline std::string getStatsPath() {
+        if (const char* runtime = std::getenv("XDG_RUNTIME_DIR"); runtime && *runtime)
+            return std::string(runtime) + "/usb_moaner-latency";
+        return "/tmp/usb_moaner-latency";
+    }
+}
+
+/**
+ * @namespace UserConfig
+ * @brief Location of the user's runtime configuration and device rules.
+ *
+ * The constants above are the built-in defaults; `RuntimeConfig` overrides
+ * them from these files at startup and whenever they change.
+ */
+namespace UserConfig {
+    /**
+     * @brief Resolve the configuration directory.
+     *
+     * `$XDG_CONFIG_HOME/usb_moaner`, falling back to `~/.config/usb_moaner`
+     * (the daemon runs as a user service).
+     */
+    inline std::string getConfigDir() {
+        if (const char* xdg = std::getenv("XDG_CONFIG_HOME"); xdg && *xdg)
+            return std::string(xdg) + "/usb_moaner";
+        if (const char* home = std::getenv("HOME"); home && *home)
+            return std::string(home) + "/.config/usb_moaner";
+        return ".";
+    }
+
+    /// File name of the `key = value` settings inside the config directory.
+    constexpr const char* CONFIG_FILE = "config";
+    /// File name of the device rules inside the config directory.
+    constexpr const char* RULES_FILE = "rules";
+    /// Quiet period after a file change before reloading (editors write in several steps).
+    constexpr int RELOAD_DEBOUNCE_MS = 100;
+
+    /// @brief Full path of the settings file.
+    inline std::string getConfigPath() { return getConfigDir() + "/" + CONFIG_FILE; }
+
+    /// @brief Full path of the device rules file.
+    inline std::string getRulesPath() { return getConfigDir() + "/" + RULES_FILE; }
+}
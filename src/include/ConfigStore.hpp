@@ -0,0 +1,111 @@
+#pragma once
+#include "RuntimeConfig.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class ConfigStore
+ * @brief Publishes `RuntimeConfig` snapshots to reader threads without locks (RCU style).
+ *
+ * The current snapshot sits behind an atomic pointer. A reload builds a new
+ * snapshot off to the side and swaps it in with one atomic exchange; readers
+ * never block and never see a half-updated configuration.
+ *
+ * ## Reclamation
+ * Replaced snapshots cannot be freed while a reader may still use them. Each
+ * reader thread owns a slot; `read()` returns a guard that stores the global
+ * epoch in the slot while the snapshot is in use and clears it afterwards.
+ * `publish()` bumps the epoch and retires the old snapshot with that epoch;
+ * `reclaim()` frees it once every slot is idle or has moved past it.
+ *
+ * ## Design Notes
+ * - Single writer: `publish()` and `reclaim()` must be called from one thread
+ *   (the presentation thread, which also owns the inotify watch).
+ * - Readers: one slot per thread, at most `MAX_READERS`, indices chosen by
+ *   the owner (`App` uses one for intake and one for presentation).
+ * - Guards are meant to be short-lived (one event); a guard held forever only
+ *   delays reclamation, it never blocks the writer.
+ *
+ * ## Usage Example
+ * ```cpp
+ * ConfigStore store(RuntimeConfig::load(configPath, rulesPath));
+ * // reader thread
+ * auto config = store.read(0);
+ * int volume = config->volumePercent;
+ * // writer thread
+ * store.publish(RuntimeConfig::load(configPath, rulesPath));
+ * ```
+ */
+class ConfigStore {
+public:
+    /// Maximum number of reader threads.
+    static constexpr size_t MAX_READERS = 4;
+
+    /**
+     * @class Snapshot
+     * @brief Read guard: keeps one snapshot alive until destroyed.
+     */
+    class Snapshot {
+    public:
+        Snapshot(Snapshot&& other) noexcept : slot(other.slot), config(other.config) { other.slot = nullptr; }
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+
+        /// @brief Marks the reader quiescent again.
+        ~Snapshot() { if (slot) slot->store(0, std::memory_order_release); }
+
+        const RuntimeConfig* operator->() const { return config; }
+        const RuntimeConfig& operator*() const { return *config; }
+
+    private:
+        friend class ConfigStore;
+        Snapshot(std::atomic<uint64_t>* slot, const RuntimeConfig* config) : slot(slot), config(config) {}
+
+        std::atomic<uint64_t>* slot;  ///< Reader slot to clear, or `nullptr` once moved from.
+        const RuntimeConfig* config;  ///< Snapshot protected by this guard.
+    };
+
+    /// @brief Starts with an initial snapshot (defaults when `nullptr`).
+    explicit ConfigStore(std::unique_ptr<RuntimeConfig> initial = nullptr);
+
+    /// @brief Frees every snapshot; no reader may be active.
+    ~ConfigStore();
+
+    ConfigStore(const ConfigStore&) = delete;
+    ConfigStore& operator=(const ConfigStore&) = delete;
+
+    /**
+     * @brief Pins and returns the current snapshot.
+     * @param reader Slot of the calling thread (< `MAX_READERS`); one guard per slot at a time.
+     */
+    Snapshot read(size_t reader) const;
+
+    /**
+     * @brief Atomically replaces the current snapshot (writer thread only).
+     * @return Version assigned to the new snapshot.
+     */
+    uint64_t publish(std::unique_ptr<RuntimeConfig> next);
+
+    /// @brief Frees retired snapshots no reader can still see (writer thread only).
+    void reclaim();
+
+    /// @brief Snapshots waiting for readers to move on.
+    size_t retiredCount() const { return retired.size(); }
+
+private:
+    /// A replaced snapshot and the epoch from which no new reader can see it.
+    struct Retired {
+        const RuntimeConfig* config;
+        uint64_t epoch;
+    };
+
+    std::atomic<const RuntimeConfig*> current{nullptr};       ///< Published snapshot.
+    std::atomic<uint64_t> epoch{1};                           ///< Bumped on every publish.
+    mutable std::array<std::atomic<uint64_t>, MAX_READERS> readers{}; ///< 0 = quiescent.
+    std::vector<Retired> retired;                             ///< Writer-owned.
+    uint64_t version = 0;                                     ///< Last version handed out.
+};
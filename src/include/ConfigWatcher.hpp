@@ -0,0 +1,56 @@
+#pragma once
+#include "EventLoop.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @class ConfigWatcher
+ * @brief Watches the configuration directory with inotify and reports edits.
+ *
+ * The directory is watched rather than the files themselves: most editors
+ * save by writing a temporary file and renaming it over the original, which
+ * would silently end a watch on the old inode.
+ *
+ * ## Design Notes
+ * - Registered on an `EventLoop`; the callback runs on that loop's thread.
+ * - Saves are bursty (truncate, write, rename, chmod...), so changes are
+ *   debounced with a timer and the callback fires once per quiet period.
+ * - Only the configured file names trigger the callback; other files in the
+ *   directory (editor swap files) are ignored.
+ * - The directory is created when missing so a first config can be dropped
+ *   in while the daemon runs.
+ */
+class ConfigWatcher {
+public:
+    /// Called once the watched files settled after a change.
+    using Callback = std::function<void()>;
+
+    ConfigWatcher() = default;
+
+    /// @brief Closes the inotify descriptor.
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    /**
+     * @brief Starts watching `dir` for changes to any of `files`.
+     * @param loop     Loop that runs the inotify handler and the debounce timer.
+     * @param dir      Directory holding the files.
+     * @param files    File names (relative to `dir`) to react to.
+     * @param debounce Quiet period before `onChange` runs.
+     * @param onChange Reload callback.
+     * @return `true` if the watch is active.
+     */
+    bool start(EventLoop& loop, const std::string& dir, std::vector<std::string> files,
+               std::chrono::milliseconds debounce, Callback onChange);
+
+private:
+    int fd = -1;                      ///< inotify instance.
+    int debounceTimer = -1;           ///< Timer id on the loop.
+    std::vector<std::string> names;   ///< Watched file names.
+
+    /// @brief Reads pending inotify events; returns `true` if a watched file changed.
+    bool drain();
+};
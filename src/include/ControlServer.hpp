@@ -0,0 +1,82 @@
+#pragma once
+#include "EventLoop.hpp"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class ControlServer
+ * @brief Local control socket: one text request in, one text reply out.
+ *
+ * Listens on an `AF_UNIX` `SOCK_SEQPACKET` socket and serves its clients from
+ * an `EventLoop`. Every packet a client sends is one request (such as
+ * `"stats"` or `"mute 30"`); the handler fills in the reply, which goes back
+ * as one packet. Packet boundaries are kept by the kernel, so the protocol
+ * needs no framing and a client is simply
+ * `socat - UNIX-CONNECT:$XDG_RUNTIME_DIR/usb_moaner.sock,type=5`
+ * or `usb_moaner-ctl`.
+ *
+ * ## Design Notes
+ * - Everything is non-blocking: a readable listener accepts every pending
+ *   client, a readable client has its pending requests answered, and a reply
+ *   that cannot be sent at once (a client that never reads) drops the client
+ *   instead of buffering. A client can cost the loop at most one request's
+ *   work per wakeup round, never a wait.
+ * - At most `ControlConfig::MAX_CLIENTS` connections are kept; extra ones are
+ *   accepted and closed right away.
+ * - The socket is created with mode 0600 and removed on destruction. A stale
+ *   socket left by a crash (nobody accepts on it) is replaced; one a running
+ *   instance still serves is left alone and `start()` fails. The probe
+ *   connect is non-blocking, so a wedged instance with a full backlog cannot
+ *   hang the new one; it counts as live.
+ * - What the commands do is up to the handler; the server only moves packets.
+ *
+ * Example usage:
+ * ```cpp
+ * ControlServer control;
+ * control.start(loop, ControlConfig::getSocketPath(), [](std::string_view request, std::string& reply) {
+ *     reply = request == "ping" ? "ok pong" : "error unknown command";
+ * });
+ * ```
+ */
+class ControlServer {
+public:
+    /// Builds the reply (cleared beforehand) to one request.
+    using Handler = std::function<void(std::string_view request, std::string& reply)>;
+
+    ControlServer() = default;
+
+    /// @brief Closes every connection and removes the socket file.
+    ~ControlServer();
+
+    ControlServer(const ControlServer&) = delete;
+    ControlServer& operator=(const ControlServer&) = delete;
+
+    /**
+     * @brief Binds the socket and serves it on `loop`.
+     * @return `false` if the socket cannot be created or another instance serves `path`.
+     */
+    bool start(EventLoop& loop, const std::string& path, Handler handler);
+
+    /// @brief Number of connected clients.
+    size_t clientCount() const { return clients.size(); }
+
+private:
+    EventLoop* loop = nullptr;  ///< Loop serving the sockets.
+    int listenFd = -1;          ///< Listening socket.
+    std::string socketPath;     ///< Bound path, removed on destruction.
+    Handler onRequest;          ///< Command implementation.
+    std::vector<int> clients;   ///< Connected client sockets.
+    std::string reply;          ///< Reply buffer, reused across requests.
+
+    /// @brief Accepts every pending connection.
+    void acceptClients();
+
+    /// @brief Answers a client's pending requests; drops it on hang-up or error.
+    void serve(int fd, uint32_t events);
+
+    /// @brief Stops watching and closes a client.
+    void drop(int fd);
+};
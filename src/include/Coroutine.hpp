@@ -0,0 +1,188 @@
+#pragma once
+#include "EventLoop.hpp"
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <utility>
+
+/**
+ * @file Coroutine.hpp
+ * @brief Minimal C++20 coroutine support for code running on an `EventLoop`.
+ *
+ * Multi-step sequences such as an alert (show, hold, fade, hide) are written
+ * as straight-line coroutines that `co_await` loop timers instead of being
+ * split across timer callbacks and state flags. Everything runs on the
+ * loop's thread: a suspended coroutine is just a frame waiting for its timer,
+ * so any number of them can be in flight without a thread each.
+ *
+ * ## Contents
+ * - `Task`: return type of a fire-and-forget coroutine. It starts running
+ *   immediately (up to its first suspension) and frees its frame when it
+ *   returns.
+ * - `CancelSource` / `CancelToken`: cooperative cancellation. `cancel()`
+ *   resumes the awaiting coroutine at once with a `false` result, so it can
+ *   clean up and return.
+ * - `LoopTimer`: a loop timer whose expiries are awaited.
+ *
+ * ## Design Notes
+ * - Single-threaded by construction: awaitables are resumed from loop
+ *   handlers or from `cancel()`, both on the loop thread. None of these types
+ *   may be shared across threads.
+ * - Awaiting returns `true` when the wait completed and `false` when it was
+ *   cancelled; a cancelled token makes every later await return `false`
+ *   immediately.
+ * - Header-only: no .cpp file.
+ *
+ * Example usage:
+ * ```cpp
+ * Task blink(EventLoop& loop, CancelToken cancel) {
+ *     LoopTimer timer(loop);
+ *     for (int i = 0; i < 3; i++) {
+ *         show();
+ *         if (!co_await timer.sleep(std::chrono::milliseconds(200), cancel)) co_return;
+ *         hide();
+ *     }
+ * }
+ * ```
+ */
+
+/**
+ * @struct Task
+ * @brief Fire-and-forget coroutine: eager start, frame freed on completion.
+ */
+struct Task {
+    struct promise_type {
+        Task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/**
+ * @class CancelToken
+ * @brief Observer side of a `CancelSource`, passed to coroutines by value.
+ */
+class CancelToken {
+public:
+    CancelToken() : state(std::make_shared<State>()) {}
+
+    /// @brief Whether the source cancelled this token.
+    bool cancelled() const { return state->cancelled; }
+
+    /// @brief Registers the single pending waiter; it runs once on cancellation.
+    void onCancel(std::function<void()> waiter) const { state->waiter = std::move(waiter); }
+
+    /// @brief Unregisters the pending waiter.
+    void clearWaiter() const { state->waiter = nullptr; }
+
+private:
+    friend class CancelSource;
+
+    struct State {
+        bool cancelled = false;
+        std::function<void()> waiter;
+    };
+    std::shared_ptr<State> state; ///< Shared with the source.
+};
+
+/**
+ * @class CancelSource
+ * @brief Cancels every token it handed out since the last `cancel()`.
+ */
+class CancelSource {
+public:
+    /// @brief A token cancelled by the next `cancel()`.
+    CancelToken token() const { return current; }
+
+    /**
+     * @brief Cancels the outstanding tokens and resumes their waiter; later tokens are fresh.
+     *
+     * The waiter runs before this returns, so the cancelled coroutine has
+     * cleaned up (and usually finished) by then.
+     */
+    void cancel() {
+        CancelToken cancelled = std::exchange(current, CancelToken());
+        cancelled.state->cancelled = true;
+        if (auto waiter = std::exchange(cancelled.state->waiter, nullptr)) waiter();
+    }
+
+private:
+    CancelToken current; ///< Token of the current generation.
+};
+
+/**
+ * @class LoopTimer
+ * @brief `EventLoop` timer whose expiries can be awaited.
+ *
+ * Owns one loop timer (a `timerfd`) for its whole life, so waiting for the
+ * next frame costs one `timerfd_settime()` or nothing at all with a periodic
+ * timer, never a descriptor per wait.
+ */
+class LoopTimer {
+public:
+    explicit LoopTimer(EventLoop& loop) : loop(loop), id(loop.addTimer([this]() { fire(); })) {}
+
+    /// @brief Removes the timer from the loop.
+    ~LoopTimer() {
+        if (id >= 0) loop.removeTimer(id);
+    }
+
+    LoopTimer(const LoopTimer&) = delete;
+    LoopTimer& operator=(const LoopTimer&) = delete;
+
+    /// @brief Arms the timer (see `EventLoop::armTimer()`).
+    void start(std::chrono::nanoseconds delay, std::chrono::nanoseconds interval = std::chrono::nanoseconds::zero()) {
+        loop.armTimer(id, delay, interval);
+    }
+
+    /// @brief Disarms the timer.
+    void stop() { loop.disarmTimer(id); }
+
+    /// Awaitable for the next expiry; yields `false` if cancelled.
+    class Expiry {
+    public:
+        Expiry(LoopTimer& timer, CancelToken cancel) : timer(timer), cancel(std::move(cancel)) {}
+
+        bool await_ready() const noexcept { return cancel.cancelled() || timer.id < 0; }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            timer.waiter = handle;
+            cancel.onCancel([this]() {
+                timer.stop();
+                std::exchange(timer.waiter, nullptr).resume();
+            });
+        }
+
+        bool await_resume() const {
+            cancel.clearWaiter();
+            return !cancel.cancelled() && timer.id >= 0;
+        }
+
+    private:
+        LoopTimer& timer;
+        CancelToken cancel;
+    };
+
+    /// @brief Waits for the next expiry of the armed timer.
+    Expiry tick(CancelToken cancel) { return Expiry(*this, std::move(cancel)); }
+
+    /// @brief Arms a one-shot `delay` and waits for it.
+    Expiry sleep(std::chrono::nanoseconds delay, CancelToken cancel) {
+        start(delay);
+        return tick(std::move(cancel));
+    }
+
+private:
+    EventLoop& loop;                        ///< Loop owning the timer.
+    int id = -1;                            ///< Timer id, -1 if creation failed.
+    std::coroutine_handle<> waiter;         ///< Coroutine awaiting the next expiry.
+
+    /// @brief Timer handler: resumes the waiting coroutine, if any.
+    void fire() {
+        if (waiter) std::exchange(waiter, nullptr).resume();
+    }
+};
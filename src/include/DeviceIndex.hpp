@@ -0,0 +1,92 @@
+#pragma once
+#include "UsbEvent.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class DeviceIndex
+ * @brief Compact, sorted set of connected USB devices, persistable as a snapshot.
+ *
+ * Used by `UsbMonitor` to notice devices plugged while the daemon was not
+ * listening (restart, suspend): the current set is compared with the last
+ * known one and only the difference is reported.
+ *
+ * ## Design Notes
+ * - A device is reduced to 12 bytes: an **identity** hashed from its port
+ *   (devpath) and VID:PID, and an **instance**, its bus and device number.
+ *   The kernel gives every enumeration a new device number, so a device
+ *   unplugged and plugged back at the same port is a new instance.
+ * - Device numbers are only meaningful within one boot. A snapshot records
+ *   the boot it was taken in; across a reboot only identities are compared,
+ *   so the usual devices re-enumerated at boot raise no alert.
+ * - Entries are kept sorted: lookups are binary searches and nothing is
+ *   allocated per device beyond the vector itself.
+ *
+ * ## File Format
+ * A 64-byte header (magic `USBMSN01`, boot id, entry count) followed by the
+ * sorted entries, 16 bytes each. Written to a temporary file and renamed.
+ *
+ * Example usage:
+ * ```cpp
+ * DeviceIndex previous;
+ * bool sameBoot = false;
+ * if (previous.load(path, sameBoot) && !previous.contains(event, sameBoot)) notify(event);
+ * ```
+ */
+class DeviceIndex {
+public:
+    /// One device.
+    struct Entry {
+        uint64_t identity = 0; ///< Hash of devpath and VID:PID.
+        uint32_t instance = 0; ///< busnum << 16 | devnum.
+
+        bool operator<(const Entry& other) const {
+            return identity != other.identity ? identity < other.identity : instance < other.instance;
+        }
+        bool operator==(const Entry& other) const {
+            return identity == other.identity && instance == other.instance;
+        }
+    };
+
+    /// @brief Key of an event's device.
+    static Entry keyOf(const UsbEvent& event);
+
+    /// @brief Adds a device (no-op if already present).
+    void insert(const UsbEvent& event);
+
+    /// @brief Removes a device (no-op if absent).
+    void erase(const UsbEvent& event);
+
+    /**
+     * @brief Whether a device is known.
+     * @param sameBoot Compare instances too; `false` for a snapshot from another boot.
+     */
+    bool contains(const UsbEvent& event, bool sameBoot = true) const;
+
+    /// @brief Forgets every device.
+    void clear() { entries.clear(); }
+
+    /// @brief Number of devices.
+    size_t size() const { return entries.size(); }
+
+    /**
+     * @brief Replaces the index with a snapshot file.
+     * @param sameBoot Set to whether the snapshot was taken during this boot.
+     * @return `false` if the file is missing or invalid; the index is then empty.
+     */
+    bool load(const std::string& path, bool& sameBoot);
+
+    /**
+     * @brief Writes the index atomically, stamped with the current boot.
+     * @return `true` on success.
+     */
+    bool save(const std::string& path) const;
+
+    /// @brief `/proc/sys/kernel/random/boot_id`, or an empty string.
+    static std::string bootId();
+
+private:
+    std::vector<Entry> entries; ///< Sorted by identity, then instance.
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include "UsbEvent.hpp"
+#include <chrono>
+#include <vector>
+
+/**
+ * @struct UsbEventBatch
+ * @brief A group of USB events merged into a single notification.
+ */
+struct UsbEventBatch {
+    /// Events of the batch, in arrival order.
+    std::vector<UsbEvent> events;
+
+    /// Receive time of the first event (used for latency measurements).
+    std::chrono::steady_clock::time_point firstReceivedAt;
+
+    /// @brief Number of devices in the batch.
+    size_t count() const { return events.size(); }
+
+    /**
+     * @brief Writes a short summary of the batch into `buf`.
+     *
+     * The summary is the single event's details, or a count followed by one
+     * "VID:PID node" line per device. It is truncated to whole lines and
+     * always NUL-terminated.
+     *
+     * @return Number of characters written, excluding the NUL.
+     */
+    size_t format(char* buf, size_t size) const;
+};
+
+/**
+ * @class EventCoalescer
+ * @brief Merges bursts of USB events into a single notification.
+ *
+ * Plugging in a hub or a dock fires many `usb_device` "add" events within
+ * milliseconds. Rather than running one full notification per device, the
+ * presentation side feeds every dequeued event to the coalescer and only
+ * notifies once the coalescing window of the first event has elapsed
+ * (or the batch is full).
+ *
+ * ## Design Notes
+ * - The window is fixed from the first event of a batch; it is not extended
+ *   by later events, so a continuous stream still notifies regularly.
+ * - Each device is logged individually as it is added, so per-device detail
+ *   is never lost even though only one alert is shown.
+ * - The batch storage is reused between batches; steady-state operation does
+ *   not allocate.
+ * - A window of 0 disables coalescing: every event is immediately due.
+ * - Not thread-safe: owned and driven by the presentation thread.
+ *
+ * ## Usage Example
+ * ```cpp
+ * EventCoalescer coalescer(std::chrono::milliseconds(250), 64);
+ * coalescer.add(event);
+ * if (coalescer.due(std::chrono::steady_clock::now()))
+ *     notify(coalescer.take());
+ * ```
+ */
+class EventCoalescer {
+public:
+    /**
+     * @param window   How long to wait after the first event for more events.
+     * @param maxBatch Batch size at which the batch is due immediately.
+     */
+    EventCoalescer(std::chrono::milliseconds window, size_t maxBatch);
+
+    /// @brief Adds an event to the current batch and logs its details.
+    void add(const UsbEvent& event);
+
+    /// @brief Whether a batch is being collected.
+    bool pending() const { return !batch.events.empty(); }
+
+    /// @brief Moment the current batch becomes due (only meaningful when `pending()`).
+    std::chrono::steady_clock::time_point deadline() const;
+
+    /// @brief Whether the current batch should be notified now.
+    bool due(std::chrono::steady_clock::time_point now) const;
+
+    /**
+     * @brief Hands out the collected batch and starts a new one.
+     *
+     * The returned reference stays valid until the next call to `take()`.
+     */
+    const UsbEventBatch& take();
+
+private:
+    std::chrono::milliseconds window; ///< Coalescing window.
+    size_t maxBatch;                  ///< Size that forces an early flush.
+    UsbEventBatch batch;              ///< Batch being collected.
+    UsbEventBatch ready;              ///< Last batch handed out by `take()`.
+};
@@ -0,0 +1,167 @@
+#pragma once
+#include "UsbEvent.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct JournalRecord
+ * @brief One USB event as stored in the `EventJournal`, 32 bytes, fixed width.
+ */
+struct JournalRecord {
+    /// `flags` bit: the event comes from a device scan, not from a live uevent.
+    static constexpr uint8_t FLAG_SCANNED = 1 << 0;
+
+    uint64_t timeNs = 0;      ///< Wall-clock time (`CLOCK_REALTIME`), ns since the Unix epoch.
+    uint64_t devpathHash = 0; ///< `UsbEvent::devpathHash()`.
+    uint16_t vendor = 0;      ///< Vendor ID.
+    uint16_t product = 0;     ///< Product ID.
+    uint16_t busnum = 0;      ///< USB bus number.
+    uint16_t devnum = 0;      ///< Device number on its bus.
+    uint8_t action = 0;       ///< `UsbAction`.
+    uint8_t flags = 0;        ///< `FLAG_*` bits.
+    uint16_t reserved = 0;
+    /// Low 32 bits of (position + 1), written last; 0 or a mismatch marks an empty or torn slot.
+    uint32_t sequence = 0;
+};
+static_assert(sizeof(JournalRecord) == 32, "journal records must stay 32 bytes");
+
+/**
+ * @struct JournalHeader
+ * @brief First page of a journal file; records follow it.
+ */
+struct JournalHeader {
+    char magic[8];                 ///< "USBMJR01".
+    uint32_t recordSize;           ///< `sizeof(JournalRecord)`.
+    uint32_t capacity;             ///< Number of record slots in the ring.
+    std::atomic<uint64_t> written; ///< Records ever appended; the next one goes to `written % capacity`.
+};
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "the journal head is shared through a file mapping");
+
+/**
+ * @class EventJournal
+ * @brief Append-only audit log of every USB event, kept in a memory-mapped ring file.
+ *
+ * `UsbMonitor` appends each event its backend reports — removals included —
+ * so the history of what was plugged in survives the daemon. The file holds
+ * the last `capacity` events; older ones are overwritten.
+ *
+ * ## Design Notes
+ * - The file is mapped `MAP_SHARED` once: appending writes 32 bytes into the
+ *   mapping and bumps the head counter, **no syscall per event**. The page
+ *   cache writes the pages back; a crash of the daemon loses nothing, only a
+ *   power loss can lose the latest records. `sync()` forces them out.
+ * - Timestamps are wall-clock (`CLOCK_REALTIME` through the vDSO), so the
+ *   journal reads across reboots and suspends.
+ * - Single writer. Readers (`JournalView`, the `usb_moaner-journal` tool) may
+ *   map the file concurrently: each record carries its sequence number,
+ *   stored last with release ordering, so a slot being overwritten is
+ *   recognised and skipped.
+ * - A file with another layout or capacity is reinitialised.
+ *
+ * ## File Format
+ * A 4096-byte page holding the `JournalHeader`, then `capacity` `JournalRecord`s.
+ *
+ * Example usage:
+ * ```cpp
+ * EventJournal journal;
+ * if (journal.open(JournalConfig::getJournalPath(), JournalConfig::CAPACITY)) journal.append(event);
+ * ```
+ */
+class EventJournal {
+public:
+    /// Size of the header page.
+    static constexpr size_t HEADER_SIZE = 4096;
+
+    EventJournal() = default;
+
+    /// @brief Flushes and unmaps the file.
+    ~EventJournal();
+
+    EventJournal(const EventJournal&) = delete;
+    EventJournal& operator=(const EventJournal&) = delete;
+
+    /**
+     * @brief Opens or creates the journal file and maps it.
+     * @param capacity Number of records kept.
+     * @return `false` if the file cannot be created or mapped.
+     */
+    bool open(const std::string& path, uint32_t capacity);
+
+    /// @brief Whether `open()` succeeded.
+    bool isOpen() const { return header != nullptr; }
+
+    /// @brief Records an event (no-op when closed).
+    void append(const UsbEvent& event, uint8_t flags = 0);
+
+    /// @brief Schedules the dirty pages for writeback (`msync(MS_ASYNC)`).
+    void sync();
+
+private:
+    JournalHeader* header = nullptr;  ///< Mapped file.
+    JournalRecord* records = nullptr; ///< Ring slots, right after the header page.
+    size_t mappedSize = 0;            ///< Length of the mapping.
+};
+
+/**
+ * @class JournalView
+ * @brief Read-only mapping of a journal file, for queries.
+ *
+ * Example usage:
+ * ```cpp
+ * JournalView view;
+ * if (view.open(path)) view.scan([](const JournalRecord& r) { ... });
+ * ```
+ */
+class JournalView {
+public:
+    JournalView() = default;
+
+    /// @brief Unmaps the file.
+    ~JournalView();
+
+    JournalView(const JournalView&) = delete;
+    JournalView& operator=(const JournalView&) = delete;
+
+    /**
+     * @brief Maps a journal file read-only.
+     * @return `false` if it is missing or not a journal.
+     */
+    bool open(const std::string& path);
+
+    /// @brief Records ever appended to the journal.
+    uint64_t written() const { return header->written.load(std::memory_order_acquire); }
+
+    /// @brief Number of record slots.
+    uint32_t capacity() const { return header->capacity; }
+
+    /**
+     * @brief Visits the retained records, oldest first.
+     *
+     * Slots overwritten while scanning are skipped.
+     * @return Number of records visited.
+     */
+    template <typename Visitor>
+    uint64_t scan(Visitor&& visit) const {
+        uint64_t end = written();
+        uint64_t begin = end > header->capacity ? end - header->capacity : 0;
+        uint64_t visited = 0;
+        for (uint64_t position = begin; position < end; position++) {
+            const JournalRecord& slot = records[position % header->capacity];
+            uint32_t expected = static_cast<uint32_t>(position + 1);
+            if (__atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE) != expected) continue;
+            JournalRecord record = slot;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (__atomic_load_n(&slot.sequence, __ATOMIC_RELAXED) != expected) continue;
+            visit(record);
+            visited++;
+        }
+        return visited;
+    }
+
+private:
+    const JournalHeader* header = nullptr;  ///< Mapped file.
+    const JournalRecord* records = nullptr; ///< Ring slots.
+    size_t mappedSize = 0;                  ///< Length of the mapping.
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+/**
+ * @class EventLoop
+ * @brief Small single-threaded reactor built on `epoll`.
+ *
+ * Every event source of the daemon is a file descriptor: the udev monitor
+ * socket, the intake → presentation `eventfd`, a `signalfd` for clean
+ * SIGTERM/SIGHUP handling and `timerfd`s for fades and debouncing. The
+ * loop waits on all of them with one `epoll_wait()` and dispatches each
+ * ready descriptor to its handler.
+ *
+ * ## Design Notes
+ * - Handlers are stored in a table indexed by file descriptor, so dispatch
+ *   is O(1) and the cost per event does not grow with the number of sources.
+ * - The loop never wakes up on its own: with no armed timer it sleeps until
+ *   a descriptor becomes ready (zero idle wakeups).
+ * - Handlers may add or remove sources (including themselves) while they run;
+ *   removed handlers are destroyed after the current dispatch round.
+ * - `stop()` is the only method that may be called from another thread.
+ * - `watchSignals()` blocks the signals in the calling thread; call it before
+ *   spawning threads so they inherit the mask and signals only reach the loop.
+ *
+ * ## Usage Example
+ * ```cpp
+ * EventLoop loop;
+ * loop.watchSignals({SIGTERM, SIGINT}, [&loop](int) { loop.stop(); });
+ * int timer = loop.addTimer([] { std::cout << "tick\n"; });
+ * loop.armTimer(timer, std::chrono::milliseconds(500));
+ * loop.run();
+ * ```
+ *
+ * ## Dependencies
+ * - Linux `epoll`, `eventfd`, `timerfd` and `signalfd`.
+ */
+class EventLoop {
+public:
+    /// Handler for a watched descriptor; receives the ready `epoll` event mask.
+    using Handler = std::function<void(uint32_t events)>;
+    /// Handler for an expired timer.
+    using TimerHandler = std::function<void()>;
+    /// Handler for a received signal; receives the signal number.
+    using SignalHandler = std::function<void(int signo)>;
+
+    EventLoop();
+
+    /// @brief Closes the epoll instance and every timer / signal descriptor it created.
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /**
+     * @brief Starts watching a descriptor (the caller keeps ownership of `fd`).
+     * @param fd      Descriptor to watch.
+     * @param events  `epoll` event mask (usually `EPOLLIN`).
+     * @param handler Called from `run()` whenever `fd` is ready.
+     * @return `true` on success.
+     */
+    bool watch(int fd, uint32_t events, Handler handler);
+
+    /// @brief Stops watching a descriptor (does not close it).
+    void unwatch(int fd);
+
+    /**
+     * @brief Creates a disarmed monotonic timer owned by the loop.
+     * @return The timer id (its `timerfd`), or -1 on failure.
+     */
+    int addTimer(TimerHandler handler);
+
+    /**
+     * @brief Arms a timer.
+     * @param timer    Id returned by `addTimer()`.
+     * @param delay    Time until the first expiry.
+     * @param interval Period of later expiries (zero = one-shot).
+     */
+    void armTimer(int timer, std::chrono::nanoseconds delay,
+                  std::chrono::nanoseconds interval = std::chrono::nanoseconds::zero());
+
+    /// @brief Disarms a timer without removing it.
+    void disarmTimer(int timer);
+
+    /// @brief Removes and closes a timer.
+    void removeTimer(int timer);
+
+    /**
+     * @brief Routes signals to the loop through a `signalfd`.
+     *
+     * The signals are blocked in the calling thread (and in threads it spawns
+     * afterwards), so they are only ever delivered through the loop.
+     *
+     * @return `true` on success.
+     */
+    bool watchSignals(std::initializer_list<int> signals, SignalHandler handler);
+
+    /// @brief Dispatches events until `stop()` is called (returns at once if it already was).
+    void run();
+
+    /// @brief Makes `run()` return after the current dispatch round (thread-safe).
+    void stop();
+
+    /// @brief Number of times `epoll_wait()` returned (for wakeup accounting).
+    uint64_t wakeups() const { return wakeupCount.load(std::memory_order_relaxed); }
+
+private:
+    int epollFd = -1;                   ///< The epoll instance.
+    int stopFd = -1;                    ///< eventfd written by `stop()`.
+    std::atomic<bool> stopping{false};  ///< Set by `stop()`; a stopped loop stays stopped.
+    std::atomic<uint64_t> wakeupCount{0};
+    std::vector<std::unique_ptr<Handler>> handlers; ///< Indexed by file descriptor (stable while the table grows).
+    std::vector<std::unique_ptr<Handler>> retired;  ///< Handlers removed during dispatch.
+    std::vector<int> ownedFds;          ///< Timer and signal descriptors to close.
+
+    /// @brief Closes a descriptor created by the loop and forgets it.
+    void closeOwned(int fd);
+};
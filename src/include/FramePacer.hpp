@@ -0,0 +1,56 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @class FramePacer
+ * @brief Sleeps until absolute frame deadlines on the monotonic clock.
+ *
+ * Used to pace the fade when the renderer cannot synchronize to vblank.
+ * `sleep_for(period)` after each frame drifts by the render and present cost
+ * plus scheduler wake-up latency, every frame; the pacer instead sleeps until
+ * `start + n * period` with `clock_nanosleep(TIMER_ABSTIME)`, so lateness in
+ * one frame is never carried into the next.
+ *
+ * ## Design Notes
+ * - A frame that finished after its deadline is not slept for; deadlines that
+ *   passed entirely are skipped rather than replayed in a burst, and counted.
+ * - Only the blocking path (`Notifier::showMessage()`) needs it: the daemon
+ *   paces frames with an interval `timerfd`, which is drift-free already.
+ *
+ * Example usage:
+ * ```cpp
+ * FramePacer pacer(std::chrono::milliseconds(16));
+ * pacer.start();
+ * while (drawNextFrame()) pacer.wait();
+ * ```
+ */
+class FramePacer {
+public:
+    /// @brief Creates a pacer for the given frame period (at least 1 ms).
+    explicit FramePacer(std::chrono::nanoseconds period);
+
+    /// @brief Sets the first deadline one period from now.
+    void start();
+
+    /**
+     * @brief Sleeps until the next deadline.
+     *
+     * If the frame overran its deadline, the pacer realigns to the next one
+     * still ahead, keeping frames on the original `start + n * period` grid.
+     *
+     * @return Number of deadlines the previous frame overran (0 when on time).
+     */
+    uint32_t wait();
+
+    /// @brief Total deadlines missed since `start()`.
+    uint64_t missed() const { return missedTotal; }
+
+    /// @brief Frame period.
+    std::chrono::nanoseconds period() const { return interval; }
+
+private:
+    std::chrono::nanoseconds interval;              ///< Frame period.
+    std::chrono::steady_clock::time_point deadline; ///< Next wake-up time.
+    uint64_t missedTotal = 0;                       ///< Skipped deadlines.
+};
@@ -0,0 +1,68 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @class IdleTracker
+ * @brief Accounts time, wakeups and resident memory of the daemon's active and idle states.
+ *
+ * The daemon alternates between **active** (presentation engine loaded:
+ * windows, renderers, audio device, decoded assets) and **idle** (all of it
+ * released after a quiet period). Each transition closes the current period
+ * and samples the resident set size, so the cost of both states can be
+ * compared from the logs.
+ *
+ * ## Design Notes
+ * - Wakeups are the sum of the event loops' `epoll_wait()` returns
+ *   (`EventLoop::wakeups()`), passed in by the owner at each transition.
+ * - RSS comes from `/proc/self/statm`: one small read, only at transitions
+ *   and reports.
+ * - Not thread-safe: owned by the presentation thread.
+ *
+ * Example usage:
+ * ```cpp
+ * IdleTracker tracker;
+ * tracker.start(loop.wakeups());
+ * tracker.enter(IdleTracker::State::Idle, loop.wakeups());
+ * tracker.report(std::cout, loop.wakeups());
+ * ```
+ */
+class IdleTracker {
+public:
+    /// Resource state of the daemon.
+    enum class State { Active, Idle };
+
+    /// Totals of one state.
+    struct Usage {
+        uint64_t periods = 0;                  ///< Times the state was entered.
+        std::chrono::nanoseconds time{0};      ///< Time spent in it (closed periods).
+        uint64_t wakeups = 0;                  ///< Loop wakeups during it (closed periods).
+        size_t rssBytes = 0;                   ///< RSS sampled when it was last entered.
+    };
+
+    /// @brief Starts the first (active) period.
+    void start(uint64_t wakeups);
+
+    /// @brief Closes the current period and opens one in `next`; samples the RSS.
+    void enter(State next, uint64_t wakeups);
+
+    /// @brief Current state.
+    State state() const { return current; }
+
+    /// @brief Totals of a state, excluding the period in progress.
+    const Usage& usage(State state) const { return totals[static_cast<int>(state)]; }
+
+    /// @brief Writes both states' totals, the period in progress included.
+    void report(std::ostream& out, uint64_t wakeups) const;
+
+    /// @brief Resident set size of this process in bytes (0 if unknown).
+    static size_t residentBytes();
+
+private:
+    State current = State::Active;                  ///< State of the open period.
+    std::chrono::steady_clock::time_point since;    ///< Start of the open period.
+    uint64_t wakeupsSince = 0;                      ///< Wakeup count at its start.
+    Usage totals[2];                                ///< Indexed by `State`.
+};
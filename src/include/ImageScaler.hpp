@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class ImageScaler
+ * @brief Resamples 32-bit RGBA images with a tent filter and converts their channel order.
+ *
+ * Used by `AssetCache` to bring the background to the display resolution
+ * once, so every frame is a 1:1 texture copy instead of a GPU rescale of a
+ * full-size PNG.
+ *
+ * ## Filter
+ * A separable tent (linear) filter whose support widens with the
+ * downscaling ratio: bilinear when enlarging, an area-weighted average of
+ * every covered source pixel when shrinking, so large backgrounds do not
+ * alias. Weights are precomputed per output row and column in 14-bit fixed
+ * point and normalized to sum exactly to one.
+ *
+ * ## Kernels
+ * - `Scalar`: portable reference.
+ * - `SSE2`: both passes on 128-bit vectors (`_mm_madd_epi16` on pairs of taps).
+ * - `AVX2`: the vertical pass, which dominates, on 256-bit vectors; the
+ *   horizontal pass is gather-bound and shares the SSE2 code.
+ *
+ * All kernels use the same integer arithmetic and produce bit-identical
+ * output; `best()` picks the widest one the CPU supports at run time, so the
+ * binary needs no `-mavx2`. Non-x86 builds only have the scalar kernel.
+ *
+ * ## Pixel Layout
+ * Input is RGBA in byte order (`SDL_PIXELFORMAT_RGBA32`). The output can
+ * swap red and blue (`ARGB8888` in little-endian memory) and force alpha to
+ * opaque (`XRGB`/`XBGR` formats) within the same pass, which covers the
+ * native formats of common GPU renderers.
+ *
+ * Example usage:
+ * ```cpp
+ * ImageScaler scaler(3840, 2160, 1920, 1080);
+ * scaler.scale(src, 3840 * 4, dst, 1920 * 4, ImageScaler::PixelLayout{true, false});
+ * ```
+ */
+class ImageScaler {
+public:
+    /// Implementation of the resampling passes.
+    enum class Kernel : uint8_t { Scalar, SSE2, AVX2 };
+
+    /// Output channel order relative to the RGBA input.
+    struct PixelLayout {
+        bool swapRedBlue = false; ///< Write BGRA bytes (`ARGB8888` on little-endian).
+        bool opaque = false;      ///< Force alpha to 255 (formats without alpha).
+    };
+
+    /// @brief Precomputes the filter weights for one source and target size.
+    ImageScaler(int srcWidth, int srcHeight, int dstWidth, int dstHeight);
+
+    /**
+     * @brief Resamples `src` into `dst`.
+     * @param src      RGBA pixels, `srcHeight` rows of `srcPitch` bytes.
+     * @param srcPitch Bytes per source row.
+     * @param dst      Output pixels, `dstHeight` rows of `dstPitch` bytes.
+     * @param dstPitch Bytes per output row.
+     * @param layout   Output channel order.
+     * @param kernel   Implementation; unsupported kernels fall back to `best()`.
+     */
+    void scale(const uint8_t* src, size_t srcPitch, uint8_t* dst, size_t dstPitch,
+               PixelLayout layout, Kernel kernel = best()) const;
+
+    /// @brief Widest kernel the running CPU supports.
+    static Kernel best();
+
+    /// @brief Whether the running CPU (and this build) supports `kernel`.
+    static bool supported(Kernel kernel);
+
+    /// @brief Human-readable kernel name.
+    static const char* name(Kernel kernel);
+
+private:
+    /// Contributions of the source pixels to one output pixel along one axis.
+    struct Taps {
+        int start = 0;          ///< First contributing source index.
+        int count = 0;          ///< Number of contributing source pixels.
+        size_t weights = 0;     ///< Offset of the first weight in `weights`.
+    };
+
+    /// Filter weights of one axis.
+    struct Axis {
+        std::vector<Taps> taps;       ///< One entry per output index.
+        std::vector<int16_t> weights; ///< 14-bit fixed-point weights, summing to 1 << 14.
+    };
+
+    int srcW, srcH, dstW, dstH;
+    Axis horizontal; ///< Source columns → output columns.
+    Axis vertical;   ///< Source rows → output rows.
+
+    /// @brief Builds the tent-filter weights mapping `srcSize` samples onto `dstSize`.
+    static Axis buildAxis(int srcSize, int dstSize);
+};
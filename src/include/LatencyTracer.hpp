@@ -0,0 +1,120 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @class LatencyHistogram
+ * @brief Lock-free, HDR-style log-linear histogram of durations.
+ *
+ * Values (nanoseconds) are bucketed by their power of two, each power split
+ * into 16 linear sub-buckets: every value is represented within 6.25%, from
+ * nanoseconds to hours, in a fixed 8 KiB table. `record()` is a handful of
+ * relaxed atomic operations, so any thread may record without locks and
+ * readers see a consistent-enough snapshot for percentiles.
+ */
+class LatencyHistogram {
+public:
+    /// Linear sub-buckets per power of two, as a bit count.
+    static constexpr int SUB_BITS = 4;
+    /// Linear sub-buckets per power of two.
+    static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BITS;
+    /// Total number of buckets (covers every 64-bit value).
+    static constexpr size_t BUCKETS = 64 * SUB_BUCKETS;
+
+    /// @brief Adds one sample; negative durations are clamped to zero.
+    void record(std::chrono::nanoseconds value);
+
+    /// @brief Number of samples.
+    uint64_t count() const { return samples.load(std::memory_order_relaxed); }
+
+    /// @brief Largest sample.
+    std::chrono::nanoseconds max() const { return std::chrono::nanoseconds(maxNs.load(std::memory_order_relaxed)); }
+
+    /// @brief Mean of all samples (0 when empty).
+    std::chrono::nanoseconds mean() const;
+
+    /**
+     * @brief Value below which a fraction `q` of the samples fall.
+     * @param q Quantile in [0, 1], e.g. 0.99.
+     * @return Upper bound of the bucket holding that sample (0 when empty).
+     */
+    std::chrono::nanoseconds percentile(double q) const;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets{}; ///< Sample counts.
+    std::atomic<uint64_t> samples{0};                     ///< Total count.
+    std::atomic<uint64_t> sumNs{0};                       ///< Sum, for the mean.
+    std::atomic<uint64_t> maxNs{0};                       ///< Largest sample.
+
+    /// @brief Bucket of a value.
+    static size_t bucketOf(uint64_t ns);
+
+    /// @brief Largest value of a bucket.
+    static uint64_t upperBound(size_t bucket);
+};
+
+/**
+ * @enum TraceStage
+ * @brief Pipeline stages between a plug and the alert, each with its own histogram.
+ *
+ * "Kernel" time is udev's `USEC_INITIALIZED`, the moment udevd started
+ * handling the kernel uevent (the kernel itself does not timestamp uevents);
+ * with the raw netlink backend it is the receive time. `SEQNUM` is carried
+ * along to correlate with `udevadm monitor --kernel`.
+ */
+enum class TraceStage : uint8_t {
+    Udev,          ///< Kernel (`USEC_INITIALIZED`) → `udev_monitor_receive_device()` returned.
+    Intake,        ///< Received → dequeued by the presentation thread (limiter, queue, wake-up).
+    Scheduling,    ///< Dequeued → overlay shown (coalescing window, rules, asset selection).
+    FirstFrame,    ///< Overlay shown → first `SDL_RenderPresent()` returned.
+    FirstAudio,    ///< Overlay shown → first audio buffer containing the alert was mixed.
+    PlugToPixel,   ///< Kernel → first frame presented.
+    PlugToSound,   ///< Kernel → first alert audio buffer.
+    Count,
+};
+
+/**
+ * @class LatencyTracer
+ * @brief Per-stage latency histograms of the plug → alert pipeline.
+ *
+ * Cheap enough to stay on in production: a stage costs one clock read (vDSO)
+ * where the timestamp is taken and a few relaxed atomics per sample, with no
+ * allocation or lock. Reports are only built when asked for, on SIGUSR1.
+ *
+ * Example usage:
+ * ```cpp
+ * LatencyTracer tracer;
+ * tracer.record(TraceStage::Intake, event.dequeuedAt - event.receivedAt);
+ * tracer.dump(std::cout);
+ * ```
+ */
+class LatencyTracer {
+public:
+    /// @brief Adds one sample to a stage.
+    void record(TraceStage stage, std::chrono::nanoseconds value) {
+        stages[static_cast<size_t>(stage)].record(value);
+    }
+
+    /// @brief Histogram of a stage.
+    const LatencyHistogram& histogram(TraceStage stage) const { return stages[static_cast<size_t>(stage)]; }
+
+    /// @brief Writes a table of count, percentiles, max and mean per stage (in ms).
+    void dump(std::ostream& out) const;
+
+    /**
+     * @brief Writes the same table to `path`, atomically replacing it.
+     * @return `true` on success.
+     */
+    bool writeFile(const std::string& path) const;
+
+    /// @brief Display name of a stage.
+    static const char* name(TraceStage stage);
+
+private:
+    std::array<LatencyHistogram, static_cast<size_t>(TraceStage::Count)> stages; ///< One per stage.
+};
@@ -0,0 +1,124 @@
+#pragma once
+#include "Config.hpp"
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @struct LoudnessTarget
+ * @brief Level `LoudnessNormalizer` brings sounds to.
+ */
+struct LoudnessTarget {
+    double loudnessLufs = AudioConfig::TARGET_LOUDNESS_LUFS; ///< Integrated loudness to reach.
+    double ceilingDbfs = AudioConfig::PEAK_CEILING_DBFS;     ///< Highest sample peak after the gain.
+    double maxGainDb = AudioConfig::MAX_GAIN_DB;             ///< Largest boost.
+    double maxLimitingDb = AudioConfig::MAX_LIMITING_DB;     ///< Largest overshoot clipped at the ceiling.
+};
+
+/**
+ * @struct LoudnessAnalysis
+ * @brief Loudness and peak of a sound.
+ */
+struct LoudnessAnalysis {
+    /// Level reported for silence.
+    static constexpr double SILENCE_DB = -200.0;
+
+    double loudnessLufs = SILENCE_DB; ///< Integrated loudness, `SILENCE_DB` when everything was gated.
+    double peakDbfs = SILENCE_DB;     ///< Sample peak, `SILENCE_DB` for digital silence.
+};
+
+/**
+ * @class LoudnessNormalizer
+ * @brief Measures the loudness of decoded 16-bit PCM and brings it to a target level.
+ *
+ * Used by `AssetCache` once per decoded alert, so every alert sound plays at
+ * the same perceived loudness without touching the system volume: the
+ * daemon used to force the default sink to the alert volume on every event
+ * and never put it back.
+ *
+ * ## Measurement
+ * - Integrated loudness follows ITU-R BS.1770: K-weighting (high shelf plus
+ *   high pass, coefficients derived for the actual sample rate), 400 ms
+ *   blocks with 75 % overlap, an absolute gate at -70 LUFS and a relative
+ *   gate 10 LU below the ungated level. Clips shorter than one block are
+ *   measured as a single block. Every channel has weight 1.
+ * - The sample peak is measured alongside, in dBFS.
+ *
+ * ## Gain
+ * The gain is the distance to `LoudnessTarget::loudnessLufs`, bounded twice:
+ * - by `LoudnessTarget::maxGainDb`, so near-silent files are not lifted into noise;
+ * - by the peak: at most `LoudnessTarget::maxLimitingDb` may end up above
+ *   `LoudnessTarget::ceilingDbfs`, where the kernel clips. Short transients lose a
+ *   few dB; sustained material is held back instead of distorted.
+ *
+ * `normalize()` runs the kernel whenever the gain is not 0 dB or the source
+ * peaks above the ceiling, so a file already at the target loudness still
+ * has its peaks clipped to `LoudnessTarget::ceilingDbfs`.
+ *
+ * ## Kernels
+ * The gain/limiter pass multiplies every sample in single precision, clamps
+ * it to the ceiling and rounds to nearest:
+ * - `Scalar`: portable reference.
+ * - `SSE2`: 8 samples per step.
+ * - `AVX2`: 16 samples per step.
+ *
+ * All kernels produce bit-identical output; `best()` picks the widest one
+ * the CPU supports at run time, so the binary needs no `-mavx2`. Non-x86
+ * builds only have the scalar kernel. The analysis is a recursive filter
+ * and stays scalar; both run once per decode, never per alert.
+ *
+ * Example usage:
+ * ```cpp
+ * auto* pcm = reinterpret_cast<int16_t*>(chunk->abuf);
+ * LoudnessNormalizer::Result result = LoudnessNormalizer::normalize(pcm, chunk->alen / 4, 2, 44100);
+ * ```
+ */
+class LoudnessNormalizer {
+public:
+    /// Implementation of the gain/limiter pass.
+    enum class Kernel : uint8_t { Scalar, SSE2, AVX2 };
+
+    /// Outcome of `normalize()`.
+    struct Result {
+        LoudnessAnalysis source;        ///< Measurement before the gain.
+        double gainDb = 0.0;            ///< Gain applied.
+        Kernel kernel = Kernel::Scalar; ///< Kernel that applied it.
+    };
+
+    /**
+     * @brief Measures integrated loudness and sample peak.
+     * @param samples    Interleaved samples, `frames * channels` of them.
+     * @param frames     Sample frames.
+     * @param channels   Interleaved channels.
+     * @param sampleRate Sample rate in Hz.
+     */
+    static LoudnessAnalysis analyze(const int16_t* samples, size_t frames, int channels, int sampleRate);
+
+    /// @brief Gain in dB bringing `analysis` to `target` within its bounds (0 for silence).
+    static double gainFor(const LoudnessAnalysis& analysis, const LoudnessTarget& target = LoudnessTarget{});
+
+    /**
+     * @brief Multiplies every sample by `gain` and clips to ±`ceiling`.
+     * @param samples Samples modified in place.
+     * @param count   Number of samples (all channels).
+     * @param gain    Linear gain.
+     * @param ceiling Largest magnitude written.
+     * @param kernel  Implementation; unsupported kernels fall back to `best()`.
+     */
+    static void applyGain(int16_t* samples, size_t count, float gain, int16_t ceiling, Kernel kernel = best());
+
+    /// @brief Measures a sound and normalizes it in place.
+    static Result normalize(int16_t* samples, size_t frames, int channels, int sampleRate,
+                            const LoudnessTarget& target = LoudnessTarget{});
+
+    /// @brief `ceilingDbfs` as a sample magnitude.
+    static int16_t ceilingSample(double ceilingDbfs);
+
+    /// @brief Widest kernel the running CPU supports.
+    static Kernel best();
+
+    /// @brief Whether the running CPU (and this build) supports `kernel`.
+    static bool supported(Kernel kernel);
+
+    /// @brief Human-readable kernel name.
+    static const char* name(Kernel kernel);
+};
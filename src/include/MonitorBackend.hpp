@@ -0,0 +1,52 @@
+#pragma once
+#include "UsbEvent.hpp"
+#include <cstddef>
+#include <functional>
+
+/**
+ * @class MonitorBackend
+ * @brief Source of USB device events behind `UsbMonitor`.
+ *
+ * A backend owns one pollable file descriptor and turns whatever arrives on
+ * it into `UsbEvent`s. `UsbMonitor` registers that descriptor on an
+ * `EventLoop` and calls `receive()` whenever it becomes readable.
+ *
+ * ## Implementations
+ * - `UdevBackend`: libudev monitor on the "udev" netlink group. Events arrive
+ *   after udevd has run its rules (device node created, attributes settled).
+ * - `NetlinkBackend`: raw `NETLINK_KOBJECT_UEVENT` socket on the kernel group.
+ *   Events arrive as soon as the kernel emits them, bypassing udevd.
+ * - `SyntheticBackend`: generated events at a configured rate and device mix,
+ *   for benchmarks on machines without USB hardware.
+ *
+ * ## Contract
+ * - `fd()` must be non-blocking; `receive()` drains everything pending and
+ *   returns without waiting.
+ * - Every action ("add", "remove", "bind", ...) of `usb/usb_device` devices
+ *   is reported; `UsbMonitor` decides which ones raise alerts.
+ */
+class MonitorBackend {
+public:
+    /// Type alias for the event callback function.
+    using Callback = std::function<void(const UsbEvent&)>;
+
+    virtual ~MonitorBackend() = default;
+
+    /// @brief Descriptor to poll for readability (-1 if the backend failed to open).
+    virtual int fd() const = 0;
+
+    /// @brief Reads every pending event without blocking.
+    virtual void receive(const Callback& onEvent) = 0;
+
+    /// @brief Called once `fd()` is watched; the default does nothing.
+    virtual void start() {}
+
+    /**
+     * @brief Reports every device already connected, as "add" events.
+     * @return Number of devices found (0 if the backend cannot enumerate).
+     */
+    virtual size_t enumerate(const Callback& onDevice) { (void)onDevice; return 0; }
+
+    /// @brief Short backend name for logs ("udev", "kernel").
+    virtual const char* name() const = 0;
+};
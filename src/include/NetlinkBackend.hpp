@@ -0,0 +1,86 @@
+#pragma once
+#include "MonitorBackend.hpp"
+#include <string_view>
+#include <cstddef>
+
+/**
+ * @struct KernelUevent
+ * @brief Fields of one kernel uevent, viewed in place inside the receive buffer.
+ *
+ * All members are `std::string_view`s into the buffer passed to
+ * `NetlinkBackend::parse()`; they are only valid until the next receive.
+ */
+struct KernelUevent {
+    std::string_view action;    ///< `ACTION=` (e.g. "add").
+    std::string_view devpath;   ///< `DEVPATH=` (e.g. "/devices/.../usb1/1-2").
+    std::string_view subsystem; ///< `SUBSYSTEM=` (e.g. "usb").
+    std::string_view devtype;   ///< `DEVTYPE=` (e.g. "usb_device").
+    std::string_view product;   ///< `PRODUCT=` as "vid/pid/bcd" in unpadded hex.
+    std::string_view devname;   ///< `DEVNAME=` relative to /dev (e.g. "bus/usb/001/004").
+    std::string_view busnum;    ///< `BUSNUM=` (e.g. "001").
+    std::string_view devnum;    ///< `DEVNUM=` (e.g. "004").
+    std::string_view seqnum;    ///< `SEQNUM=` kernel sequence number.
+};
+
+/**
+ * @class NetlinkBackend
+ * @brief `MonitorBackend` reading kernel uevents straight from `NETLINK_KOBJECT_UEVENT`.
+ *
+ * `UdevBackend` only sees an event after udevd has run every matching rule,
+ * which can take tens of milliseconds. This backend subscribes to the
+ * kernel's own multicast group instead and sees the event as soon as it is
+ * emitted. The trade-off: `/dev` nodes may not exist yet and no udev
+ * properties are available, which the alert does not need.
+ *
+ * ## Design Notes
+ * - A classic BPF socket filter, attached with `SO_ATTACH_FILTER`, drops every
+ *   uevent that is not `DEVTYPE=usb_device` inside the kernel, so interfaces,
+ *   endpoints and unrelated subsystems never wake the daemon. BPF cannot loop,
+ *   so the program is generated as an unrolled scan for the `DEVT` prefix over
+ *   the first `SCAN_BYTES` bytes, jumping to a shared check of the remainder.
+ * - Messages whose sender is not the kernel (`nl_pid != 0`) are ignored.
+ * - `parse()` walks the `KEY=value\0` buffer in place and returns string
+ *   views: no allocation happens while parsing.
+ * - `PRODUCT=46d/c534/1203` is parsed straight into the numeric IDs, the same
+ *   way `UdevBackend` does, so both backends produce identical events.
+ * - Connected devices are enumerated through libudev (`UdevBackend::scanDevices`),
+ *   which only reads sysfs and udev's database and needs no running udevd.
+ *
+ * ## Dependencies
+ * - Linux netlink and socket filter headers.
+ */
+class NetlinkBackend : public MonitorBackend {
+public:
+    /// Bytes of each message scanned by the BPF filter for `DEVTYPE=`.
+    static constexpr int SCAN_BYTES = 768;
+
+    /// @brief Opens and binds the uevent socket and attaches the BPF filter.
+    NetlinkBackend();
+
+    /// @brief Closes the socket.
+    ~NetlinkBackend() override;
+
+    NetlinkBackend(const NetlinkBackend&) = delete;
+    NetlinkBackend& operator=(const NetlinkBackend&) = delete;
+
+    int fd() const override { return sock; }
+    void receive(const Callback& onEvent) override;
+    size_t enumerate(const Callback& onDevice) override;
+    const char* name() const override { return "kernel"; }
+
+    /**
+     * @brief Parses a raw uevent message in place.
+     * @param data Message bytes (`ACTION@DEVPATH\0KEY=value\0...`).
+     * @param size Message length.
+     * @param out  Receives views into `data`.
+     * @return `false` if the message is not a kernel uevent.
+     */
+    static bool parse(const char* data, size_t size, KernelUevent& out);
+
+private:
+    int sock = -1;          ///< The NETLINK_KOBJECT_UEVENT socket.
+    char buffer[8192];      ///< Receive buffer reused for every message.
+
+    /// @brief Attaches the in-kernel `usb_device` filter.
+    bool attachFilter();
+};
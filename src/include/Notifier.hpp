@@ -1,5 +1,78 @@
 #pragma once
-#include <string>
+#include "AssetCache.hpp"
+#include "SoundGenerator.hpp"
+#include "TextOverlay.hpp"
+#include "Config.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+struct SDL_Window;
+struct SDL_Renderer;
+
+/**
+ * @struct FirstFrameStats
+ * @brief Aggregated plug-to-first-frame latency measurements.
+ *
+ * Each sample is the time between the moment a USB event was received
+ * and the moment its first overlay frame was presented.
+ */
+struct FirstFrameStats {
+    uint64_t samples = 0;   ///< Number of notifications measured.
+    double lastMs = 0.0;    ///< Latency of the most recent notification.
+    double minMs = 0.0;     ///< Fastest notification observed.
+    double maxMs = 0.0;     ///< Slowest notification observed.
+    double totalMs = 0.0;   ///< Sum of all samples (for the average).
+
+    /// @brief Mean latency over all samples, or 0 when nothing was measured.
+    double averageMs() const { return samples ? totalMs / samples : 0.0; }
+};
+
+/**
+ * @struct FrameStats
+ * @brief Fade rendering measurements, to catch slow presents on weak GPUs.
+ *
+ * Present times cover `SDL_RenderPresent()` alone, which includes the wait
+ * for vblank when vsync is on. A frame counts as a missed deadline when it
+ * came more than one and a half frame periods after the previous one.
+ */
+struct FrameStats {
+    uint64_t fades = 0;           ///< Fades rendered to the end.
+    uint64_t frames = 0;          ///< Frames presented (first frames included).
+    uint64_t missedDeadlines = 0; ///< Fade frames that came too late.
+    double lastPresentMs = 0.0;   ///< Present time of the latest frame.
+    double maxPresentMs = 0.0;    ///< Slowest present observed.
+    double totalPresentMs = 0.0;  ///< Sum of all present times (for the average).
+    double lastFadeMs = 0.0;      ///< Wall time of the latest fade.
+    double maxFadeMs = 0.0;       ///< Longest fade observed.
+
+    /// @brief Mean present time over all frames, or 0 when nothing was presented.
+    double averagePresentMs() const { return frames ? totalPresentMs / frames : 0.0; }
+};
+
+/**
+ * @struct AlertTiming
+ * @brief Milestones of the latest alert, for `LatencyTracer`.
+ */
+struct AlertTiming {
+    std::chrono::steady_clock::time_point shownAt;      ///< Overlay windows shown.
+    std::chrono::steady_clock::time_point firstFrameAt; ///< First `SDL_RenderPresent()` returned.
+};
+
+/**
+ * @struct AlertStyle
+ * @brief Per-alert presentation settings (from the runtime config and device rules).
+ */
+struct AlertStyle {
+    int assetSet = -1;                               ///< Extra asset set, -1 for the defaults.
+    int fadeDelayMs = FadeConfig::DELAY_BEFORE_FADE_MS; ///< Full-opacity time before the fade.
+    int fadeSpeed = FadeConfig::FADE_SPEED;          ///< Alpha step per nominal fade frame.
+    int frameDelayMs = FadeConfig::FRAME_DELAY_MS;   ///< Nominal fade frame period.
+    int volumePercent = AudioConfig::VOLUME_PERCENT; ///< Alert playback volume.
+    int priority = AudioConfig::DEFAULT_PRIORITY;    ///< Voice-stealing priority of the sound.
+};
 
 /**
  * @class Notifier
@@ -12,10 +85,13 @@
  *
  * ## Responsibilities
  * - Initialize and configure SDL video subsystems in both GUI and daemon contexts.
- * - Display a fullscreen, borderless window (simulating a modal overlay).
+ * - Keep a fullscreen, borderless window (simulating a modal overlay) on every
+ *   display alive for the whole daemon lifetime, hidden between alerts.
  * - Render an image background, or a fallback color if missing.
+ * - Show the alert's message (the triggering devices) over it (`TextOverlay`).
  * - Play an audio clip (via `SoundGenerator`) simultaneously.
  * - Apply a smooth fade-out animation over time.
+ * - Record the plug-to-first-frame latency of every alert.
  *
  * ## Design Notes
  * - Works both when executed from a desktop session and as a **systemd user daemon**.
@@ -24,39 +100,293 @@
  * - Uses `std::filesystem` to detect correct asset paths:
  *   - Development mode → `../resource/Layout/background.png`
  *   - Installed daemon → `/opt/usb_moaner/background.png`
+ * - The SDL video context, windows, renderers and audio device are created once
+ *   by `init()` and reused: an alert only shows the windows, draws and hides them.
+ *
+ * ## Multiple Displays
+ * - `init()` opens one window and renderer per display reported by
+ *   `SDL_GetNumVideoDisplays()`, covering that display's bounds. A display
+ *   that fails to open is skipped.
+ * - Every `AssetCache` decodes its image once and prepares one texture per
+ *   display, resampling them concurrently (see `AssetCache`).
+ * - Each frame computes one opacity, draws every display, then presents them
+ *   all: the fade starts and advances in the same frame everywhere.
+ * - Only the first display's renderer waits for vblank and paces the fade;
+ *   the others present immediately. Vsync on every window would serialize
+ *   one vblank wait per display and grow the time to first frame with the
+ *   display count.
+ * - Assets are decoded once into `AssetCache`s (the defaults plus any set
+ *   registered by `configureAssets()`); `reloadAssets()` refreshes them.
  * - The fade animation uses `SDL_SetTextureAlphaMod()` for performance and simplicity.
+ * - The message is laid out once by `begin()` from a glyph atlas built by
+ *   `init()`; each frame draws it with one `SDL_RenderGeometry()` call per
+ *   display and fades it with the background.
+ *
+ * ## Fade Timing
+ * - The fade lasts `ceil(255 / fadeSpeed) * frameDelayMs`, the nominal
+ *   duration of the old fixed-step animation, and each frame's alpha is
+ *   derived from the monotonic clock. Late or dropped frames therefore
+ *   never stretch the fade; they only make it coarser.
+ * - The pacing renderer is created with `SDL_RENDERER_PRESENTVSYNC` when
+ *   `FadeConfig::VSYNC` allows it and the driver honours it; frames are then
+ *   paced at the display refresh rate (`frameInterval()`). Without vsync,
+ *   frames are paced at the alert's frame delay, by the daemon's interval
+ *   timer or, in `showMessage()`, by a `FramePacer`.
+ * - Present times, missed deadlines and fade durations are collected in
+ *   `frameStats()` and logged after every fade.
+ * - `alertTiming()` and `takeFirstAudio()` expose the show, first-present and
+ *   first-audio-buffer times of the latest alert for the daemon's `LatencyTracer`.
  *
  * ## Lifecycle
- * 1. `showMessage()` initializes SDL and creates a fullscreen renderer.
- * 2. Loads the background image and displays it.
- * 3. Spawns a thread to play the alert sound.
- * 4. Gradually fades the screen to black.
- * 5. Cleans up all SDL resources and exits gracefully.
+ * 1. `init()` initializes SDL, creates a hidden fullscreen window and renderer,
+ *    opens the audio device and fills the asset cache.
+ * 2. `begin()` shows the window, presents the first frame and starts the
+ *    alert sound without blocking; the owner watches `audioFd()` and calls
+ *    `onAudioFinished()` so other streams are restored when it ends.
+ * 3. `advanceFade()`, called once per `frameInterval()` (the daemon drives it
+ *    from a coroutine awaiting a `timerfd` on its event loop), fades the
+ *    screen to black, then hides the window again. Calling `begin()` before
+ *    the fade ends replaces the alert on screen.
+ * 4. `shutdown()` (or the destructor) releases all SDL resources.
+ *
+ * `shutdown()` followed by `init()` is supported: the daemon releases the
+ * whole engine (SDL, windows, audio device and PulseAudio connection,
+ * decoded assets) when idle and builds it again on the next event. The
+ * asset paths survive, and the resampled background is mapped back from
+ * its disk cache, so a rebuild does not decode the PNG again.
+ *
+ * `startInit()` builds the engine in two halves so the caller's event loop
+ * is not held up by audio: SDL video, windows, renderers and textures need
+ * the video thread and are created right away, while opening the audio
+ * device, connecting to PulseAudio and decoding and normalizing the alerts
+ * run on a helper thread. `warmupFd()` signals the end of that half and
+ * `completeInit()` joins it. Any other call needing the engine meanwhile
+ * (`init()`, `begin()`, `configureAssets()`, `shutdown()`) joins it first.
+ *
+ * `showMessage()` runs steps 2–3 in a blocking loop for simple callers.
  *
  * ## Dependencies
- * - SDL2 (`libsdl2-2.0-0`)
+ * - SDL2 (`libsdl2-2.0-0`, 2.0.18 or later)
  * - SDL2_image (`libsdl2-image-2.0-0`)
  * - SDL2_mixer (`libsdl2-mixer-2.0-0`)
  * - `SoundGenerator` for audio control.
+ * - `AssetCache` for decoded image and sound data.
+ * - `TextOverlay` for the event details.
  * - `Config.hpp` for timing and resource path settings.
  *
  * ## Example
  * ```cpp
  * Notifier notifier;
+ * notifier.init();
  * notifier.showMessage("USB Connected", "New device detected!");
  * ```
  */
 class Notifier {
 public:
+    /// @brief Starts with the default assets of `Config.hpp`.
+    Notifier();
+
+    /// @brief Releases the window, renderer and textures.
+    ~Notifier();
+
+    Notifier(const Notifier&) = delete;
+    Notifier& operator=(const Notifier&) = delete;
+
+    /**
+     * @brief Creates the long-lived SDL video context and hidden overlay window.
+     *
+     * Safe to call again after a failure (e.g. the display was not ready yet
+     * when the daemon started); does nothing when already initialized.
+     *
+     * @return `true` if the presentation engine is ready.
+     */
+    bool init();
+
+    /**
+     * @brief Starts building the engine without blocking the caller on audio.
+     *
+     * Creates the video context, windows, renderers and textures on the
+     * calling (video) thread, then opens the audio device and decodes the
+     * alert sounds on a helper thread. Builds everything synchronously when
+     * no eventfd is available.
+     *
+     * @return `false` if the video part failed; nothing is left running then.
+     */
+    bool startInit();
+
+    /// @brief Readable once the helper thread of `startInit()` is done.
+    int warmupFd() const { return warmFd; }
+
+    /**
+     * @brief Joins the helper thread of `startInit()`; blocks if it still runs.
+     * @return `true` if the engine is ready.
+     */
+    bool completeInit();
+
+    /// @brief Whether `startInit()` left its helper thread running.
+    bool isWarming() const { return warming; }
+
+    /**
+     * @brief Shows the overlay, presents its first frame and starts the sound.
+     *
+     * Returns immediately; the fade is driven by `advanceFade()`.
+     *
+     * @param title       Window title (not visible in fullscreen mode).
+     * @param message     Text drawn over the background (e.g. the devices), or `nullptr`.
+     * @param triggeredAt Moment the triggering event was received.
+     * @param style       Assets, fade timing and volume of this alert.
+     * @return `true` if the overlay is shown.
+     */
+    bool begin(const char* title, const char* message,
+               std::chrono::steady_clock::time_point triggeredAt,
+               const AlertStyle& style = AlertStyle{});
+
+    /**
+     * @brief Sets the default assets and the extra asset sets (e.g. from device rules).
+     *
+     * Every set is decoded once and selected per alert through
+     * `AlertStyle::assetSet`. Does nothing when the paths did not change;
+     * otherwise, after `init()`, the new assets are decoded immediately.
+     * Must not be called while an alert is on screen.
+     *
+     * @return `true` if the caches were rebuilt, so a `reloadAssets()` right
+     *         after would only decode the same files again.
+     */
+    bool configureAssets(const AssetPaths& defaults, const std::vector<AssetPaths>& sets);
+
+    /**
+     * @brief Sets the mixer buffer and voice count used when `init()` opens the device.
+     *
+     * The audio device stays open until `shutdown()`, so changes after
+     * `init()` apply the next time it is opened.
+     */
+    void configureAudio(int bufferSamples, int voices);
+
+    /**
+     * @brief Renders the fade frame for the current time; hides the overlay after the last one.
+     *
+     * Does not draw while the alert is still held at full opacity.
+     *
+     * @return `true` while more frames are needed.
+     */
+    bool advanceFade();
+
+    /// @brief Period at which `advanceFade()` should be called for the alert on screen.
+    std::chrono::nanoseconds frameInterval() const;
+
+    /// @brief Whether presents are synchronized to the display's vblank.
+    bool vsyncEnabled() const { return vsync; }
+
+    /// @brief Hides the overlay immediately (e.g. on shutdown).
+    void finish();
+
+    /// @brief Readable when alert sounds finished playing (valid before `init()`).
+    int audioFd() const { return sound.completionFd(); }
+
+    /// @brief Retires finished sounds; call when `audioFd()` is readable.
+    void onAudioFinished() { sound.onChannelsFinished(); }
+
+    /// @brief Collects when the mixer first pulled the latest alert's samples (see `SoundGenerator::takeFirstBuffer`).
+    bool takeFirstAudio(std::chrono::steady_clock::time_point& at) { return sound.takeFirstBuffer(at); }
+
+    /// @brief Milestones of the latest alert started by `begin()`.
+    const AlertTiming& alertTiming() const { return timing; }
+
+    /// @brief Whether an alert is currently on screen.
+    bool isFading() const { return fading; }
+
+    /// @brief Whether the engine is built (`init()` or `completeInit()`) and `shutdown()` was not called since.
+    bool isReady() const { return ready; }
+
+    /// @brief Number of alert sounds still playing.
+    int playingVoices() const { return sound.playingVoices(); }
+
     /**
      * @brief Displays a fullscreen alert window and plays a sound.
-     * 
-     * This function blocks execution while rendering the fade animation.
-     * It is designed to be triggered by the USB monitoring loop whenever
-     * a new device is connected.
      *
-     * @param title   Window title (not visible in fullscreen mode).
-     * @param message Optional descriptive message for logs or overlays.
+     * This function blocks execution while rendering the fade animation and
+     * until the sound has finished.
+     *
+     * @param title       Window title (not visible in fullscreen mode).
+     * @param message     Text drawn over the background, or `nullptr`.
+     * @param triggeredAt Moment the triggering event was received, used to
+     *                    measure the plug-to-first-frame latency.
+     */
+    void showMessage(const char* title, const char* message,
+                     std::chrono::steady_clock::time_point triggeredAt = std::chrono::steady_clock::now());
+
+    /**
+     * @brief Decodes the background and alert again from disk.
+     * @return `true` if at least one asset is available afterwards.
      */
-    void showMessage(const std::string& title, const std::string& message) const;
+    bool reloadAssets();
+
+    /// @brief Destroys the overlay windows, closes the audio device, frees the assets and shuts SDL down.
+    void shutdown();
+
+    /// @brief Memory held by the decoded assets.
+    AssetFootprint assetFootprint() const;
+
+    /// @brief Plug-to-first-frame latency measured so far.
+    const FirstFrameStats& firstFrameStats() const { return latency; }
+
+    /// @brief Fade rendering measurements so far.
+    const FrameStats& frameStats() const { return frames; }
+
+private:
+    /// Overlay window of one display.
+    struct Screen {
+        int display = 0;                  ///< SDL display index.
+        SDL_Window* window = nullptr;     ///< Hidden-between-alerts overlay window.
+        SDL_Renderer* renderer = nullptr; ///< Renderer bound to `window`.
+    };
+
+    std::vector<Screen> screens;      ///< One per display; the first paces the fade.
+    SoundGenerator sound{"NotifierSound"}; ///< Audio device, opened once.
+    std::vector<std::unique_ptr<AssetCache>> caches; ///< Default assets first, then the extra sets.
+    std::vector<AssetPaths> cachePaths; ///< Paths of `caches`, to skip no-op reconfigurations.
+    TextOverlay caption;              ///< Message of the alert on screen, on every display.
+    AssetCache* current = nullptr;    ///< Assets of the alert on screen.
+    std::chrono::steady_clock::time_point fadeStartAt; ///< End of the full-opacity hold.
+    std::chrono::steady_clock::time_point lastFrameAt; ///< Latest present, for missed deadlines.
+    std::chrono::nanoseconds fadeDuration{0};  ///< Wall time of the fade on screen.
+    std::chrono::nanoseconds frameDelay{0};    ///< Nominal frame period of the alert on screen.
+    std::chrono::nanoseconds refreshPeriod{0}; ///< Display refresh period (vsync pacing).
+    bool vsync = false;               ///< Presents wait for vblank.
+    uint64_t fadeFrames = 0;          ///< Frames of the fade on screen.
+    int audioBuffer = AudioConfig::BUFFER_SAMPLES; ///< Mixer buffer for `init()`.
+    int audioVoices = AudioConfig::VOICES;  ///< Voice pool size for `init()`.
+    bool ready = false;               ///< Indicates if `init()` succeeded.
+    bool warming = false;             ///< `warmup` runs the audio half of `startInit()`.
+    std::thread warmup;               ///< Helper thread of `startInit()`.
+    int warmFd = -1;                  ///< Signalled by `warmup` when it is done.
+    bool fading = false;              ///< An alert is on screen.
+    uint8_t alpha = 0;                ///< Current overlay opacity.
+    FirstFrameStats latency;          ///< Plug-to-first-frame measurements.
+    FrameStats frames;                ///< Fade rendering measurements.
+    AlertTiming timing;               ///< Milestones of the latest alert.
+
+    /// @brief Creates the video context, the screens, the textures and the caption atlas.
+    bool initVideo();
+
+    /// @brief Opens the audio device and decodes the alert sounds (no video state).
+    void initAudio();
+
+    /// @brief Draws and presents one overlay frame on every display, timing the presents.
+    void drawFrame(uint8_t alpha);
+
+    /**
+     * @brief Creates the window and renderer of one display.
+     * @param paced Whether this renderer should wait for vblank.
+     */
+    bool openScreen(Screen& screen, bool paced);
+
+    /// @brief Renderers of all screens, in `screens` order.
+    std::vector<SDL_Renderer*> renderers() const;
+
+    /// @brief Records and logs a fade that ran to the end.
+    void recordFade(std::chrono::steady_clock::time_point now);
+
+    /// @brief Records one plug-to-first-frame sample.
+    void recordFirstFrame(std::chrono::steady_clock::time_point triggeredAt);
 };
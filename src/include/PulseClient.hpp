@@ -0,0 +1,85 @@
+#pragma once
+#include "StreamControl.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+
+struct pa_threaded_mainloop;
+struct pa_context;
+struct pa_operation;
+
+/**
+ * @class PulseClient
+ * @brief In-process PulseAudio control client built on the libpulse async API.
+ *
+ * Replaces the former `pactl`/`awk`/`tail` shell pipelines: stream discovery,
+ * and muting all go through one long-lived `pa_context`
+ * driven by a `pa_threaded_mainloop`, so an alert costs a few protocol
+ * round trips instead of dozens of forked processes.
+ *
+ * ## Design Notes
+ * - Our own stream is identified by its `application.name` property
+ *   (set through `PULSE_PROP_application.name` by `SoundGenerator::init()`),
+ *   not by guessing the most recent sink-input.
+ * - Mute requests for all streams are issued back to back and awaited
+ *   together, so muting N streams costs one round trip, not N.
+ * - Only streams that were audible and muted by us are restored.
+ * - The context subscribes to sink-input events, so `awaitStream()` wakes up
+ *   the moment the server announces a new stream instead of sleeping and
+ *   re-querying.
+ * - The server is resolved by libpulse as usual (`PULSE_SERVER`, client.conf),
+ *   which allows pointing the client at a local stand-in server.
+ *
+ * ## Dependencies
+ * - libpulse (`libpulse0`)
+ */
+class PulseClient : public StreamControl {
+public:
+    /// @brief Snapshot of one playback stream.
+    struct SinkInput {
+        uint32_t index;       ///< Sink-input index.
+        bool muted;           ///< Mute state at query time.
+        std::string appName;  ///< `application.name` property (may be empty).
+    };
+
+    /// @brief Construct the client; `clientName` is shown by PulseAudio tools.
+    explicit PulseClient(const std::string& clientName = "USB Moaner control");
+
+    /// @brief Disconnects and stops the mainloop thread.
+    ~PulseClient() override;
+
+    PulseClient(const PulseClient&) = delete;
+    PulseClient& operator=(const PulseClient&) = delete;
+
+    bool connect() override;
+    int64_t findStream(const std::string& appName) override;
+    int64_t awaitStream(const std::string& appName, std::chrono::milliseconds timeout) override;
+    void muteAllExcept(uint32_t keepId) override;
+    void restoreAll() override;
+
+    /// @brief Closes the connection and releases the mainloop.
+    void disconnect() override;
+
+private:
+    std::string name;                        ///< Client name announced to the server.
+    pa_threaded_mainloop* mainloop = nullptr; ///< Thread running libpulse callbacks.
+    pa_context* context = nullptr;           ///< Connection to the server.
+    std::vector<uint32_t> mutedByUs;         ///< Streams to unmute in `restoreAll()`.
+    std::mutex streamMutex;                  ///< Guards `streamsAdded`.
+    std::condition_variable streamAdded;     ///< Signalled on every new sink-input.
+    uint64_t streamsAdded = 0;               ///< New sink-inputs seen since `connect()`.
+
+    /// @brief Subscription callback; runs on the mainloop thread.
+    static void onSubscription(pa_context* context, int type, uint32_t index, void* userdata);
+
+    /// @brief Lists every sink-input in one request. Mainloop lock must be held.
+    std::vector<SinkInput> listSinkInputs();
+
+    /// @brief Blocks until `op` completes, then releases it. Mainloop lock must be held.
+    void await(pa_operation* op);
+
+    /// @brief Checks that the context is connected and ready.
+    bool isReady() const;
+};
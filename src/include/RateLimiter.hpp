@@ -0,0 +1,132 @@
+#pragma once
+#include "UsbEvent.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class TokenBucket
+ * @brief Classic token bucket: `burst` tokens, refilled continuously at `refillPerSec`.
+ */
+class TokenBucket {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TokenBucket(double burst, double refillPerSec, Clock::time_point now);
+
+    /// @brief Consumes one token if available.
+    bool tryTake(Clock::time_point now);
+
+    /// @brief Whether the bucket has refilled completely (nothing to remember).
+    bool full(Clock::time_point now) const;
+
+    /// @brief Refills the bucket to its burst size.
+    void reset(Clock::time_point now);
+
+private:
+    double burst;          ///< Maximum tokens.
+    double refillPerSec;   ///< Tokens regained per second.
+    double tokens;         ///< Tokens available at `updatedAt`.
+    Clock::time_point updatedAt;
+
+    /// @brief Tokens available at `now`.
+    double available(Clock::time_point now) const;
+};
+
+/**
+ * @struct RateLimiterStats
+ * @brief Snapshot of the limiter's counters.
+ */
+struct RateLimiterStats {
+    uint64_t allowed = 0;          ///< Events let through.
+    uint64_t deviceLimited = 0;    ///< Events rejected by a per-device bucket.
+    uint64_t globalLimited = 0;    ///< Events rejected by the global bucket.
+    uint64_t quarantineDrops = 0;  ///< Events dropped from quarantined devices.
+    uint64_t quarantines = 0;      ///< Number of quarantines started.
+    size_t trackedDevices = 0;     ///< Devices with limiter state.
+    size_t quarantinedDevices = 0; ///< Devices currently quarantined.
+
+    /// @brief Every event that was not notified.
+    uint64_t suppressed() const { return deviceLimited + globalLimited + quarantineDrops; }
+};
+
+/**
+ * @class RateLimiter
+ * @brief Storm protection for flapping devices, applied before events are queued.
+ *
+ * A faulty cable or a device stuck in a reset loop re-enumerates continuously.
+ * Without protection each "add" turns into a full-screen alert with sound.
+ * The limiter keeps one token bucket per device, keyed by
+ * `vendor:product:devpath`, plus one global bucket shared by all devices.
+ *
+ * ## Policy
+ * - An event passes only if both its device bucket and the global bucket
+ *   have a token; otherwise it is counted as suppressed.
+ * - A device that keeps getting rejected (`QUARANTINE_AFTER` rejections with no
+ *   accepted event in between) is quarantined for `QUARANTINE_MS`: all its
+ *   events are dropped and counted without touching the buckets.
+ * - Suppressed events are summarized in the log when a quarantine starts and
+ *   ends, and when a rate-limited device is accepted again, instead of one
+ *   line per event.
+ *
+ * ## Design Notes
+ * - `allow()` must only be called from one thread (the intake thread);
+ *   `stats()` is atomic and may be read from any thread.
+ * - Idle devices whose bucket has refilled are forgotten periodically, so
+ *   the table only holds recently active devices.
+ * - Limits come from `RateLimitConfig` in `Config.hpp`.
+ */
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Outcome of `allow()`.
+    enum class Verdict {
+        Allow,        ///< Notify.
+        DeviceLimit,  ///< The device exceeded its own rate.
+        GlobalLimit,  ///< All devices together exceeded the global rate.
+        Quarantined   ///< The device is flapping and temporarily ignored.
+    };
+
+    RateLimiter();
+
+    /**
+     * @brief Decides whether an event may trigger a notification.
+     * @param event The incoming event.
+     * @param now   Current monotonic time.
+     */
+    Verdict allow(const UsbEvent& event, Clock::time_point now = Clock::now());
+
+    /// @brief Current counters (safe from any thread).
+    RateLimiterStats stats() const;
+
+private:
+    /// @brief Limiter state of one device.
+    struct DeviceState {
+        TokenBucket bucket;              ///< Per-device rate.
+        int rejectStreak = 0;            ///< Rejections since the last accepted event.
+        uint64_t suppressed = 0;         ///< Events not notified since the last summary.
+        Clock::time_point quarantinedUntil{};
+    };
+
+    TokenBucket global;                                  ///< Shared by all devices.
+    std::unordered_map<std::string, DeviceState> devices; ///< Keyed by vendor:product:devpath.
+    std::string keyBuffer;                               ///< Reused key storage.
+    Clock::time_point nextPrune;                         ///< Next idle-device cleanup.
+
+    std::atomic<uint64_t> allowedCount{0};
+    std::atomic<uint64_t> deviceLimitedCount{0};
+    std::atomic<uint64_t> globalLimitedCount{0};
+    std::atomic<uint64_t> quarantineDropCount{0};
+    std::atomic<uint64_t> quarantineCount{0};
+    std::atomic<size_t> trackedCount{0};
+    std::atomic<size_t> quarantinedCount{0};
+
+    /// @brief Rejects an event, quarantining the device if it keeps flapping.
+    Verdict reject(const std::string& key, DeviceState& state, Verdict reason, Clock::time_point now);
+
+    /// @brief Forgets devices that are idle and fully refilled.
+    void prune(Clock::time_point now);
+};
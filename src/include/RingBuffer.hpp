@@ -0,0 +1,114 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @struct QueueStats
+ * @brief Snapshot of a `RingBuffer`'s counters.
+ */
+struct QueueStats {
+    size_t depth = 0;      ///< Items currently waiting.
+    size_t highWater = 0;  ///< Largest depth ever observed by the producer.
+    uint64_t pushed = 0;   ///< Items accepted.
+    uint64_t dropped = 0;  ///< Items rejected because the buffer was full.
+};
+
+/**
+ * @class RingBuffer
+ * @brief Bounded, lock-free single-producer / single-consumer queue.
+ *
+ * Used to hand `UsbEvent`s from the udev intake thread to the presentation
+ * thread without either side ever blocking the other: a slow display can
+ * only make the buffer fill up (and count drops), never stall device intake.
+ *
+ * ## Design Notes
+ * - Exactly one thread may call `push()` and exactly one thread may call `pop()`.
+ * - `Capacity` must be a power of two; indices grow monotonically and are
+ *   masked, so the full capacity is usable.
+ * - Producer and consumer indices live on separate cache lines, and each side
+ *   caches the other's index to avoid touching the shared line on every call.
+ * - Statistics are plain relaxed atomics and may be read from any thread.
+ * - Header-only: no .cpp file.
+ *
+ * @tparam T        Element type (default-constructible, move-assignable).
+ * @tparam Capacity Maximum number of queued elements (power of two).
+ */
+template <typename T, size_t Capacity>
+class RingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "RingBuffer capacity must be a power of two");
+
+public:
+    /**
+     * @brief Enqueues an element (producer thread only).
+     * @return `false` if the buffer was full; the element is dropped and counted.
+     */
+    bool push(T item) {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - cachedHead >= Capacity) {
+            cachedHead = headIndex.load(std::memory_order_acquire);
+            if (tail - cachedHead >= Capacity) {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
+        slots[tail & (Capacity - 1)] = std::move(item);
+        tailIndex.store(tail + 1, std::memory_order_release);
+        pushedCount.fetch_add(1, std::memory_order_relaxed);
+
+        size_t depth = tail + 1 - cachedHead;
+        if (depth > highWaterMark.load(std::memory_order_relaxed))
+            highWaterMark.store(depth, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Dequeues the oldest element (consumer thread only).
+     * @return `false` if the buffer was empty.
+     */
+    bool pop(T& out) {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == cachedTail) {
+            cachedTail = tailIndex.load(std::memory_order_acquire);
+            if (head == cachedTail) return false;
+        }
+
+        out = std::move(slots[head & (Capacity - 1)]);
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Number of queued elements (approximate when read concurrently).
+    size_t size() const {
+        return tailIndex.load(std::memory_order_acquire) - headIndex.load(std::memory_order_acquire);
+    }
+
+    /// @brief Fixed capacity of the buffer.
+    static constexpr size_t capacity() { return Capacity; }
+
+    /// @brief Current counters (safe from any thread).
+    QueueStats stats() const {
+        QueueStats s;
+        s.depth = size();
+        s.highWater = highWaterMark.load(std::memory_order_relaxed);
+        s.pushed = pushedCount.load(std::memory_order_relaxed);
+        s.dropped = droppedCount.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    alignas(64) std::atomic<size_t> headIndex{0}; ///< Next slot to read (written by consumer).
+    size_t cachedTail = 0;                        ///< Consumer's view of `tailIndex`.
+
+    alignas(64) std::atomic<size_t> tailIndex{0}; ///< Next slot to write (written by producer).
+    size_t cachedHead = 0;                        ///< Producer's view of `headIndex`.
+    std::atomic<size_t> highWaterMark{0};
+    std::atomic<uint64_t> pushedCount{0};
+    std::atomic<uint64_t> droppedCount{0};
+
+    alignas(64) std::array<T, Capacity> slots{};
+};
@@ -0,0 +1,191 @@
+#pragma once
+#include "UsbEvent.hpp"
+#include "AssetCache.hpp"
+#include "Config.hpp"
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct RuleAction
+ * @brief What to do with a device matched by a rule.
+ */
+struct RuleAction {
+    /// How the device is announced.
+    enum class Kind : uint8_t {
+        Alert,  ///< Full overlay and sound (the default).
+        Silent, ///< Logged only, no overlay or sound.
+        Ignore, ///< Dropped at intake, not even logged.
+    };
+
+    Kind kind = Kind::Alert;  ///< Announcement kind.
+    int assetSet = -1;        ///< Index into `RuleEngine::assetSets()`, -1 for the default assets.
+    int fadeDelayMs = -1;     ///< Delay before the fade (-1 = `FadeConfig` default).
+    int fadeSpeed = 0;        ///< Alpha step per frame (0 = `FadeConfig` default).
+    int frameDelayMs = 0;     ///< Delay between fade frames (0 = `FadeConfig` default).
+    int priority = AudioConfig::DEFAULT_PRIORITY; ///< Voice-stealing priority of the sound.
+};
+
+/**
+ * @class RuleEngine
+ * @brief Per-device rules mapping vendor:product (and devpath) to an alert action.
+ *
+ * Rules are read from a small text file (`UserConfig::getRulesPath()`), one
+ * per line; `#` starts a comment:
+ *
+ * ```
+ * # match            [devpath=PREFIX]   actions...
+ * 046d:c534                             silent
+ * 046d:*                                background=/home/me/logi.png sound=/home/me/logi.mp3
+ * *:*                devpath=/devices/pci0000:00/0000:00:14.0/usb1/1-4   ignore
+ * 1234:5678                             fade=0,2,16 priority=10
+ * ```
+ *
+ * Actions: `alert` (default), `silent`, `ignore`, `background=PATH`,
+ * `sound=PATH`, `fade=DELAY_MS,SPEED,FRAME_MS` and `priority=N` (sounds of
+ * higher priority win the voice pool). Paths cannot contain spaces.
+ *
+ * ## Matching
+ * The most specific rule wins: exact `vid:pid`, then `vid:*`, then `*:*`.
+ * Within one key, the longest matching devpath prefix wins, then the earliest
+ * line. A device no rule matches gets the default `RuleAction` (alert).
+ *
+ * ## Design Notes
+ * - At load time the rules are sorted and **compiled** into plain arrays:
+ *   two open-addressing hash tables keyed on the packed 32-bit
+ *   `vid << 16 | pid` (and on the 16-bit vendor for `vid:*`), a list of
+ *   12-byte `Entry` records (prefix offset and length, action index)
+ *   and one character pool holding every devpath prefix. Identical actions
+ *   are stored once, so thousands of rules usually share a few cache lines
+ *   of `RuleAction`s. No `std::string` is touched during a lookup.
+ * - Each slot points at a decision list that already includes the
+ *   fallbacks: an exact key's list continues with its vendor's rules, then
+ *   the `*:*` rules, and always ends with an unconditional entry (the first
+ *   rule without a prefix, or the default action). Fallback lists are linked,
+ *   not copied, so a `*:*` rule is stored once. A lookup is two independent
+ *   probes (exact and vendor, issued together); the `*:*` list needs none.
+ * - Tables are at most half full, in 8-byte slots. A key always sits within
+ *   `WINDOW` slots (one cache line) of its hash, so a probe compares a fixed
+ *   window without data-dependent branches: hits and misses cost the same,
+ *   and a random mix of them does not stall on mispredictions.
+ * - The engine is immutable once loaded. It lives inside a `RuntimeConfig`
+ *   snapshot: editing the file builds a new engine that is published through
+ *   `ConfigStore`, so both threads call `match()` without locks.
+ * - Distinct background/sound pairs are collected into `assetSets()` so the
+ *   `Notifier` can decode each of them once, like the default assets.
+ */
+class RuleEngine {
+public:
+    /**
+     * @brief Loads and compiles a rules file.
+     *
+     * A missing file is not an error (no rules). Malformed lines are reported
+     * with their line number and skipped.
+     *
+     * @return `true` if the file was read (even partially).
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Loads and compiles rules from a stream.
+     * @param in     Rules text.
+     * @param origin Name used in error messages.
+     */
+    void load(std::istream& in, const std::string& origin);
+
+    /// @brief Action for an event (the default action when no rule matches).
+    const RuleAction& match(const UsbEvent& event) const;
+
+    /// @brief Action for a packed `vid << 16 | pid` and devpath.
+    const RuleAction& match(uint32_t id, const char* devpath) const;
+
+    /// @brief Background/sound pairs referenced by `RuleAction::assetSet`.
+    const std::vector<AssetPaths>& assetSets() const { return assets; }
+
+    /// @brief Number of compiled rules.
+    size_t size() const { return ruleCount; }
+
+    /// @brief Packs a vendor and product ID into a lookup key.
+    static constexpr uint32_t pack(uint16_t vendor, uint16_t product) {
+        return static_cast<uint32_t>(vendor) << 16 | product;
+    }
+
+private:
+    /// Match specificity; lower values are tried first.
+    enum class Tier : uint8_t { Exact, Vendor, Any };
+
+    /// One parsed rule; only used while loading.
+    struct Rule {
+        Tier tier;                 ///< Which table the rule goes to.
+        uint32_t key;              ///< Packed vid:pid (Exact) or vendor (Vendor).
+        std::string devpathPrefix; ///< Empty matches every devpath.
+        int line;                  ///< Source line, for ordering and messages.
+        RuleAction action;         ///< What to do on a match.
+        uint32_t actionIndex = 0;  ///< Index of `action` in `actions`, set by `compile()`.
+    };
+
+    /// One step of a compiled decision list.
+    struct Entry {
+        uint32_t prefix = 0;       ///< Offset of the devpath prefix in `prefixes`.
+        uint32_t prefixLength = 0; ///< 0 matches every devpath and ends the list.
+        uint32_t target = 0;       ///< Index into `actions`, or into `entries` with `LINK` set.
+    };
+
+    /// `Entry::target` flag: an unconditional jump to another list.
+    static constexpr uint32_t LINK = 0x80000000u;
+
+    /// `Slot::first` of an empty slot.
+    static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+
+    /// Slots a key may sit in, starting at its hash: one cache line.
+    static constexpr uint32_t WINDOW = 8;
+
+    /// Hash table slot.
+    struct Slot {
+        uint32_t key = 0;       ///< Packed vid:pid or vendor.
+        uint32_t first = EMPTY; ///< First entry of the key's decision list.
+    };
+
+    /**
+     * Flat hash table from a key to its decision list. Every key sits within
+     * `WINDOW` slots of its hash (the table grows until that holds), so a
+     * lookup scans one fixed window without branching on what it finds.
+     */
+    struct Table {
+        std::vector<Slot> slots; ///< `mask + WINDOW` slots, at most half full.
+        uint32_t mask = 0;       ///< Hash mask (power of two minus one).
+
+        /// @brief Builds the table from `(key, first)` pairs with unique keys.
+        void build(const std::vector<Slot>& pairs);
+
+        /// @brief First entry of `key`'s list, or `EMPTY`.
+        uint32_t find(uint32_t key) const;
+    };
+
+    size_t ruleCount = 0;              ///< Rules loaded.
+    std::vector<RuleAction> actions;   ///< Distinct actions of the rules; index 0 is the default.
+    std::vector<Entry> entries;        ///< Every decision list, back to back.
+    std::string prefixes;              ///< Devpath prefixes referenced by `entries`.
+    Table exact;                       ///< Packed vid:pid → list.
+    Table byVendor;                    ///< Vendor of `vid:*` rules → list.
+    uint32_t anyFirst = 0;             ///< List of the `*:*` rules (or just the default).
+    std::vector<AssetPaths> assets;    ///< Distinct asset pairs used by rules.
+
+    /// @brief Parses one line; returns `false` (with `error` set) if malformed.
+    bool parseLine(const std::string& line, int number, Rule& out, std::string& error);
+
+    /// @brief Sorts the rules and builds the lookup tables.
+    void compile(std::vector<Rule>& rules);
+
+    /**
+     * @brief Appends the decision list of one key.
+     * @param begin,end Rules of the key, most specific prefix first.
+     * @param next      List to continue with when no rule is unconditional.
+     * @return Index of the list's first entry.
+     */
+    uint32_t appendList(const Rule* begin, const Rule* end, uint32_t next);
+
+    /// @brief Action of the first entry of list `first` matching `devpath`.
+    const RuleAction& resolve(uint32_t first, const char* devpath) const;
+};
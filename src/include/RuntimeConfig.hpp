@@ -0,0 +1,61 @@
+#pragma once
+#include "AssetCache.hpp"
+#include "RuleEngine.hpp"
+#include "Config.hpp"
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+
+/**
+ * @struct RuntimeConfig
+ * @brief Immutable snapshot of every setting that can change without a rebuild.
+ *
+ * Built from the built-in defaults of `Config.hpp`, overridden by the user's
+ * `config` file, plus the compiled device `rules`. A snapshot is never
+ * modified once published through `ConfigStore`; a reload builds a new one.
+ *
+ * ## File Format
+ * `key = value` per line, `#` starts a comment, unknown keys are reported:
+ *
+ * ```
+ * volume = 80              # alert voice volume, 0–100
+ * fade_delay_ms = 100
+ * fade_speed = 5           # 1–255 alpha per frame
+ * frame_delay_ms = 16
+ * background = /home/me/Pictures/alert.png
+ * sound = /home/me/Music/alert.mp3
+ * audio_buffer = 512       # sample frames, read when the audio device opens
+ * voices = 4               # overlapping alerts, read when the audio device opens
+ * idle_release_s = 300     # release video, audio and assets after this quiet time, 0 = never
+ * ```
+ *
+ * Invalid values keep the default and are reported with their line number.
+ */
+struct RuntimeConfig {
+    int volumePercent = AudioConfig::VOLUME_PERCENT;      ///< Alert playback volume.
+    int fadeDelayMs = FadeConfig::DELAY_BEFORE_FADE_MS;   ///< Delay before the fade starts.
+    int fadeSpeed = FadeConfig::FADE_SPEED;               ///< Alpha step per fade frame.
+    int frameDelayMs = FadeConfig::FRAME_DELAY_MS;        ///< Delay between fade frames.
+    int audioBufferSamples = AudioConfig::BUFFER_SAMPLES; ///< Mixer buffer (applied when the device opens).
+    int voices = AudioConfig::VOICES;                     ///< Voice pool size (applied when the device opens).
+    int idleReleaseSec = IdleConfig::RELEASE_AFTER_S;     ///< Quiet time before releasing resources (0 = never).
+    AssetPaths assets;  ///< Default assets; empty entries use the installed/dev files.
+    RuleEngine rules;   ///< Per-device rules.
+    uint64_t version = 0; ///< Incremented by `ConfigStore` on every publish.
+
+    /**
+     * @brief Builds a snapshot from the settings and rules files.
+     *
+     * Missing files are not errors: the defaults (and no rules) are used.
+     */
+    static std::unique_ptr<RuntimeConfig> load(const std::string& configPath,
+                                               const std::string& rulesPath);
+
+    /**
+     * @brief Applies `key = value` settings from a stream.
+     * @param in     Settings text.
+     * @param origin Name used in error messages.
+     */
+    void parse(std::istream& in, const std::string& origin);
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include "EventLoop.hpp"
+#include <functional>
+
+struct sd_bus;
+struct sd_bus_slot;
+struct sd_bus_message;
+
+/**
+ * @class SleepWatcher
+ * @brief Reports system suspend and resume from logind's `PrepareForSleep` signal.
+ *
+ * Subscribes to `org.freedesktop.login1.Manager.PrepareForSleep` on the
+ * system bus and dispatches it on an `EventLoop`: the handler gets `true`
+ * just before the machine sleeps and `false` once it has resumed.
+ *
+ * ## Design Notes
+ * - Only a signal match is registered (no method calls, no inhibitor lock),
+ *   so the bus connection is read-only after `start()` and its descriptor is
+ *   watched for input alone.
+ * - Without a system bus (containers, non-systemd hosts) `start()` fails and
+ *   the daemon simply does not react to resume.
+ *
+ * ## Dependencies
+ * - libsystemd (sd-bus)
+ *
+ * Example usage:
+ * ```cpp
+ * SleepWatcher sleep;
+ * sleep.start(loop, [&](bool sleeping) { if (!sleeping) monitor.reconcile(); });
+ * ```
+ */
+class SleepWatcher {
+public:
+    /// Called with `true` before suspend, `false` after resume.
+    using Handler = std::function<void(bool sleeping)>;
+
+    SleepWatcher() = default;
+
+    /// @brief Drops the match and closes the bus connection.
+    ~SleepWatcher();
+
+    SleepWatcher(const SleepWatcher&) = delete;
+    SleepWatcher& operator=(const SleepWatcher&) = delete;
+
+    /**
+     * @brief Connects to the system bus and watches it on `loop`.
+     * @return `true` if the subscription is active.
+     */
+    bool start(EventLoop& loop, Handler handler);
+
+private:
+    sd_bus* bus = nullptr;        ///< System bus connection.
+    sd_bus_slot* slot = nullptr;  ///< `PrepareForSleep` match.
+    Handler onSleep;              ///< User callback.
+
+    /// @brief sd-bus signal callback.
+    static int prepareForSleep(sd_bus_message* message, void* self, struct sd_bus_error* error);
+};
@@ -1,5 +1,19 @@
 #pragma once
+#include "StreamControl.hpp"
+#include "Config.hpp"
 #include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <atomic>
+
+struct Mix_Chunk;
 
 /**
  * @class SoundGenerator
@@ -12,9 +26,8 @@
  *
  * ## Responsibilities
  * - Initialize and shut down the SDL2 audio subsystem safely.
- * - Play a sound effect (MP3) asynchronously at a specified volume.
- * - Use PulseAudio (`pactl`) to:
- *   - Maximize system volume for the alert sound.
+ * - Play a pre-decoded sound effect (`Mix_Chunk`, see `AssetCache`) at a specified volume.
+ * - Use PulseAudio (through a `StreamControl` backend, `PulseClient` by default) to:
  *   - Mute other running audio streams during playback.
  *   - Restore all sound streams afterward.
  *
@@ -24,66 +37,180 @@
  *   - `XDG_RUNTIME_DIR`
  *   - `SDL_AUDIODRIVER`
  *   ensuring audio works inside a daemon context (no graphical session needed).
- * - All system-level interactions are handled through shell commands (`pactl`).
- * - Playback is blocking but lightweight; it runs in a detached thread from
- *   the `Notifier` to avoid freezing rendering.
+ * - All system-level interactions go through one in-process libpulse connection;
+ *   no shell command or `pactl` process is spawned.
+ * - Our own stream is found by its `application.name` (the `name` given to the
+ *   constructor), so other applications' newest streams are never mistaken for it.
+ * - The audio device is opened once by `init()` with a small buffer
+ *   (`AudioConfig::BUFFER_SAMPLES`) and stays open; the alert is decoded once
+ *   by `AssetCache` at the device's output format and normalized to a common
+ *   loudness (`LoudnessNormalizer`).
+ * - The alert volume is applied to the playing voice (`Mix_Volume()`); the
+ *   system sink volume is never touched.
+ *
+ * ## Event-Driven Lifecycle
+ * Nothing sleeps or polls:
+ * - `play()` starts a channel and returns immediately.
+ * - SDL_mixer reports finished (or halted) channels through
+ *   `Mix_ChannelFinished`; the callback, running on the audio thread, only
+ *   sets a bit and signals `completionFd()`, an eventfd the owner watches on
+ *   its event loop and answers with `onChannelsFinished()`.
+ * - `init()` blocks (it connects to PulseAudio and opens the device) but
+ *   touches no video state, so the `Notifier` may run it off the event loop;
+ *   everything else is called from the owner's thread.
+ * - PulseAudio round trips (mute, restore) run in order on one
+ *   **worker thread** owned by this object: started by `init()`, drained and
+ *   joined by `cleanup()`, so no job can outlive the generator.
+ * - Our stream is awaited through the server's sink-input subscription
+ *   (`StreamControl::awaitStream`) instead of a fixed delay before muting.
+ * - `play()` and `onChannelsFinished()` must be called from the same thread.
+ * - For latency tracing, `play()` hooks a one-shot mixer effect on the
+ *   channel: the first time the mixer pulls samples of the alert, the audio
+ *   thread stores the time and signals `completionFd()` as well;
+ *   `takeFirstBuffer()` collects it.
+ *
+ * ## Voice Pool
+ * `init()` allocates a fixed pool of mixer channels (`AudioConfig::VOICES`),
+ * so overlapping alerts are mixed instead of cutting each other off. When
+ * every voice is busy, the lowest-priority voice is stolen (the oldest one
+ * among equals); a voice playing a higher-priority alert than the new one is
+ * never stolen, the new alert stays silent instead. Other streams are muted
+ * while at least one voice plays and restored as soon as the last one ends.
  *
  * ## Typical Lifecycle
  * 1. Call `init()` once to set up SDL audio and PulseAudio.
- * 2. Call `play()` with the path to a sound file (e.g., `alert.mp3`).
- * 3. Call `cleanup()` during shutdown to release resources.
+ * 2. Watch `completionFd()` and call `onChannelsFinished()` when readable.
+ * 3. Call `play()` with a decoded chunk for every alert.
+ * 4. Call `cleanup()` during shutdown to release resources.
  *
  * ## Dependencies
  * - SDL2 (`libsdl2-2.0-0`)
  * - SDL2_mixer (`libsdl2-mixer-2.0-0`)
- * - PulseAudio (`pulseaudio-utils`)
+ * - PulseAudio client library (`libpulse0`)
  *
  * Example usage:
  * ```cpp
  * SoundGenerator sound("NotifierSound");
  * if (sound.init()) {
- *     sound.play("/opt/usb_moaner/alert.mp3", 100);
+ *     loop.watch(sound.completionFd(), EPOLLIN, [&](uint32_t) { sound.onChannelsFinished(); });
+ *     sound.play(assets.alert(), 100);
  * }
  * ```
  */
 class SoundGenerator {
 public:
-    /// @brief Construct the sound generator with an optional application name.
-    explicit SoundGenerator(const std::string& name = "NotifierSound");
+    /**
+     * @brief Construct the sound generator with an optional application name.
+     * @param name     Application name announced to PulseAudio.
+     * @param control  Stream control backend; a `PulseClient` when `nullptr`.
+     */
+    explicit SoundGenerator(const std::string& name = "NotifierSound",
+                            std::unique_ptr<StreamControl> control = nullptr);
 
     /// @brief Automatically stops and cleans up the audio subsystem on destruction.
     ~SoundGenerator();
 
+    SoundGenerator(const SoundGenerator&) = delete;
+    SoundGenerator& operator=(const SoundGenerator&) = delete;
+
     /**
      * @brief Initializes the audio subsystem and configures environment variables.
+     * @param bufferSamples Mixer buffer size in sample frames.
+     * @param voices        Number of mixer channels in the voice pool (at most 32).
      * @return `true` if initialization succeeded, `false` otherwise.
      */
-    bool init();
+    bool init(int bufferSamples = AudioConfig::BUFFER_SAMPLES, int voices = AudioConfig::VOICES);
+
+    /**
+     * @brief Sets the PulseAudio and SDL audio environment variables `init()` relies on.
+     *
+     * `init()` calls it too. Call it first from the owning thread when
+     * `init()` is going to run on another one: `setenv()` must not race with
+     * other threads, so `init()` leaves the environment alone afterwards.
+     */
+    void prepareEnvironment();
 
     /**
-     * @brief Plays an audio file at the specified volume.
+     * @brief Starts a decoded sound at the specified volume and returns immediately.
      *
-     * Automatically mutes all other audio streams while playing and restores
-     * them afterward. Safe to call from separate threads.
+     * Mutes all other audio streams while any voice plays; they are restored
+     * once `onChannelsFinished()` sees the last voice end.
      *
-     * @param soundPath      Absolute path to the MP3 file.
-     * @param volumePercent  Playback volume (0–100).
+     * @param chunk          Decoded alert samples (ignored when `nullptr`).
+     * @param volumePercent  Voice volume (0–100), relative to the normalized loudness.
+     * @param priority       Voice-stealing priority (higher wins).
+     * @return `true` if a voice was started.
      */
-    void play(const std::string& soundPath, int volumePercent = 100);
+    bool play(Mix_Chunk* chunk, int volumePercent = 100, int priority = AudioConfig::DEFAULT_PRIORITY);
+
+    /// @brief eventfd that becomes readable when channels finished playing (valid before `init()`).
+    int completionFd() const { return finishedFd; }
 
-    /// @brief Shuts down SDL audio and releases all resources.
+    /// @brief Retires finished voices; restores other streams after the last one.
+    void onChannelsFinished();
+
+    /// @brief Number of voices currently playing.
+    int playingVoices() const { return activeVoices; }
+
+    /**
+     * @brief Collects the time the mixer first pulled samples of the latest alert.
+     * @param at Receives the (monotonic) time.
+     * @return `false` if that buffer has not been mixed yet or was already taken.
+     */
+    bool takeFirstBuffer(std::chrono::steady_clock::time_point& at);
+
+    /**
+     * @brief Shuts down SDL audio, disconnects from PulseAudio and releases all resources.
+     *
+     * `init()` may be called again afterwards (the daemon does so when it
+     * leaves idle mode).
+     */
     void cleanup();
 
 private:
+    /// State of one mixer channel of the pool.
+    struct Voice {
+        bool active = false;                             ///< Counted in `activeVoices`.
+        int priority = 0;                                ///< Priority of the alert it plays.
+        std::chrono::steady_clock::time_point startedAt; ///< For oldest-first stealing.
+    };
+
     std::string appName;  ///< Name used to identify the app in PulseAudio.
     bool audioReady = false; ///< Indicates if audio was successfully initialized.
+    bool environmentReady = false; ///< `prepareEnvironment()` already ran.
+    std::unique_ptr<StreamControl> streams; ///< Mute / volume backend.
+
+    std::vector<Voice> voices;   ///< One entry per mixer channel.
+    int activeVoices = 0;        ///< Playing voices; others stay muted while > 0.
+    int finishedFd = -1;         ///< Signalled by the channel-finished callback.
+    std::atomic<uint32_t> finishedChannels{0}; ///< Bit per channel that reported completion.
+    std::atomic<bool> firstBufferPending{false}; ///< Armed by `play()`, cleared by the audio thread.
+    std::atomic<int64_t> firstBufferNs{0};       ///< steady_clock time of the first mixed buffer (0: none).
 
-    /// @brief Retrieve the latest active PulseAudio stream ID.
-    int getLatestSinkInputId();
+    std::thread worker;                       ///< Runs PulseAudio jobs in order.
+    std::mutex jobMutex;                      ///< Guards `jobs` and `stopping`.
+    std::condition_variable jobReady;         ///< Wakes the worker.
+    std::deque<std::function<void()>> jobs;   ///< Pending PulseAudio jobs.
+    bool stopping = false;                    ///< Worker exits once `jobs` is empty.
+
+    /// Generator receiving SDL_mixer's (context-free) channel callbacks.
+    static std::atomic<SoundGenerator*> callbackTarget;
+
+    /// @brief `Mix_ChannelFinished` hook; runs on the SDL audio thread.
+    static void channelFinished(int channel);
+
+    /// @brief Mixer effect stamping the first buffer of an alert; runs on the SDL audio thread.
+    static void firstBuffer(int channel, void* stream, int length, void* self);
+
+    /**
+     * @brief Picks a free channel or the voice to steal.
+     * @return Channel index, or -1 when only higher-priority voices are playing.
+     */
+    int pickVoice(int priority) const;
 
-    /// @brief Mute all other audio streams except this app’s.
-    void muteAllExcept(int keepId);
+    /// @brief Queues a job for the worker thread.
+    void post(std::function<void()> job);
 
-    /// @brief Restore volume for all previously muted streams.
-    void restoreAll();
+    /// @brief Worker thread body.
+    void runJobs();
 };
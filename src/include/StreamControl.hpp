@@ -0,0 +1,60 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <chrono>
+
+/**
+ * @class StreamControl
+ * @brief Abstract backend for controlling the system's audio streams.
+ *
+ * `SoundGenerator` uses a `StreamControl` to find its own playback stream,
+ * silence every other stream while an alert plays and restore them afterwards.
+ * Keeping this behind an interface lets the production PulseAudio client
+ * (`PulseClient`) be swapped for a mock or a no-op backend, e.g. when
+ * exercising the pipeline on a headless machine.
+ *
+ * ## Contract
+ * - `connect()` must be called (and succeed) before any other method.
+ * - Stream ids are backend-specific (PulseAudio sink-input indices).
+ * - `restoreAll()` only undoes what `muteAllExcept()` changed; streams the
+ *   user muted themselves stay muted.
+ * - Every method may block on the sound server; callers keep them off
+ *   latency-sensitive threads (`SoundGenerator` runs them on its worker).
+ */
+class StreamControl {
+public:
+    virtual ~StreamControl() = default;
+
+    /**
+     * @brief Establishes the connection to the sound server.
+     * @return `true` once the backend is ready to serve requests.
+     */
+    virtual bool connect() = 0;
+
+    /**
+     * @brief Finds the playback stream owned by the given application.
+     * @param appName Value of the stream's `application.name` property.
+     * @return The stream id, or `-1` if no such stream exists.
+     */
+    virtual int64_t findStream(const std::string& appName) = 0;
+
+    /**
+     * @brief Waits until the application's playback stream exists.
+     *
+     * Returns as soon as the server reports the stream, without polling.
+     *
+     * @param appName Value of the stream's `application.name` property.
+     * @param timeout Longest time to wait.
+     * @return The stream id, or `-1` if it did not appear in time.
+     */
+    virtual int64_t awaitStream(const std::string& appName, std::chrono::milliseconds timeout) = 0;
+
+    /// @brief Mutes every playback stream except `keepId`.
+    virtual void muteAllExcept(uint32_t keepId) = 0;
+
+    /// @brief Unmutes every stream muted by the last `muteAllExcept()`.
+    virtual void restoreAll() = 0;
+
+    /// @brief Drops the connection (and any thread serving it); `connect()` opens a new one.
+    virtual void disconnect() {}
+};
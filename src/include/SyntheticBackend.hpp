@@ -0,0 +1,101 @@
+#pragma once
+#include "MonitorBackend.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct SyntheticDevice
+ * @brief One VID:PID of a `SyntheticProfile`'s device mix.
+ */
+struct SyntheticDevice {
+    uint16_t vendor = 0;  ///< Vendor ID.
+    uint16_t product = 0; ///< Product ID.
+    unsigned weight = 1;  ///< Relative share of the generated events.
+};
+
+/**
+ * @struct SyntheticProfile
+ * @brief Shape of the load produced by a `SyntheticBackend`.
+ */
+struct SyntheticProfile {
+    double eventsPerSec = 200.0;       ///< Average rate; 0 floods as fast as the intake drains.
+    unsigned burstSize = 1;            ///< Events released together (a hub or dock plug).
+    uint64_t totalEvents = 2000;       ///< Events to generate before going quiet.
+    std::vector<SyntheticDevice> mix;  ///< Device mix; a single Logitech receiver when empty.
+    uint32_t seed = 1;                 ///< Seed of the device picker.
+
+    /**
+     * @brief Parses a device mix such as "046d:c534*3,0781:5567".
+     * @return `false` if an entry is malformed; `out` is left untouched.
+     */
+    static bool parseMix(std::string_view text, std::vector<SyntheticDevice>& out);
+};
+
+/**
+ * @class SyntheticBackend
+ * @brief `MonitorBackend` generating "add" events instead of reading a socket.
+ *
+ * Drives the real pipeline (limiter, queue, coalescer, notifier) on machines
+ * with no USB hardware to plug, such as headless CI boxes.
+ *
+ * ## Design Notes
+ * - Its descriptor is a `timerfd` ticking every `burstSize / eventsPerSec`;
+ *   each tick releases one burst, so the pipeline is woken exactly like by a
+ *   real monitor socket. The load is open-loop: ticks missed while the
+ *   intake thread was busy are caught up on the next wakeup.
+ * - Every event gets its own devpath, bus and device number, so per-device
+ *   rate limiting does not apply; the VID:PID follows the weighted mix.
+ * - Events carry a `SEQNUM` but no kernel time: tracing starts at receipt.
+ * - The timer is armed by `start()`, once the monitor is watched, so slow
+ *   start-up work (SDL, assets) does not turn into an initial backlog.
+ * - `emitted()`, `finished()` and `elapsed()` may be read from any thread.
+ *
+ * Example usage:
+ * ```cpp
+ * SyntheticProfile profile;
+ * profile.eventsPerSec = 500;
+ * profile.burstSize = 8;
+ * UsbMonitor monitor(std::make_unique<SyntheticBackend>(profile));
+ * ```
+ */
+class SyntheticBackend : public MonitorBackend {
+public:
+    /// @brief Creates the (disarmed) generator timer.
+    explicit SyntheticBackend(SyntheticProfile profile);
+
+    /// @brief Closes the timer.
+    ~SyntheticBackend() override;
+
+    SyntheticBackend(const SyntheticBackend&) = delete;
+    SyntheticBackend& operator=(const SyntheticBackend&) = delete;
+
+    int fd() const override { return timer; }
+    void receive(const Callback& onEvent) override;
+    void start() override;
+    const char* name() const override { return "synthetic"; }
+
+    /// @brief Events generated so far.
+    uint64_t emitted() const { return count.load(std::memory_order_relaxed); }
+
+    /// @brief Whether every event of the profile was generated.
+    bool finished() const { return done.load(std::memory_order_acquire); }
+
+    /// @brief Time from `start()` to the last generated event (so far).
+    std::chrono::nanoseconds elapsed() const { return std::chrono::nanoseconds(elapsedNs.load(std::memory_order_relaxed)); }
+
+private:
+    SyntheticProfile profile;              ///< Load shape.
+    std::vector<unsigned> cumulative;      ///< Running sum of the mix weights.
+    int timer = -1;                        ///< Generator timerfd.
+    uint64_t state;                        ///< xorshift64 state of the device picker.
+    std::chrono::steady_clock::time_point startedAt; ///< When the timer was armed.
+    std::atomic<uint64_t> count{0};        ///< Events generated.
+    std::atomic<int64_t> elapsedNs{0};     ///< `startedAt` → latest event.
+    std::atomic<bool> done{false};         ///< All events generated.
+
+    /// @brief Fills in the `index`-th event.
+    void generate(uint64_t index, UsbEvent& event);
+};
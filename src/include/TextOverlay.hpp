@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct SDL_Renderer;
+
+/**
+ * @class TextOverlay
+ * @brief Draws a few lines of text (the triggering devices) over the alert from a glyph atlas.
+ *
+ * The `Notifier` receives a summary of every alert (action, VID:PID, node, or
+ * the device count of a coalesced batch); this class puts it on screen, in a
+ * translucent box at the bottom left of every display.
+ *
+ * ## Responsibilities
+ * - Rasterize the baked bitmap font (`GlyphFont.hpp`) once into a small
+ *   atlas texture per renderer.
+ * - Lay the text out once per alert: one textured quad per visible glyph,
+ *   plus one quad for the backdrop.
+ * - Draw it every frame at the overlay's opacity.
+ *
+ * ## Design Notes
+ * - All glyphs and the backdrop go out in **one** `SDL_RenderGeometry()` call
+ *   per display. The backdrop samples a solid cell of the atlas, so it needs
+ *   no separate fill or texture switch.
+ * - Vertex and index buffers are sized for `MAX_GLYPHS` by `load()`; the index
+ *   buffer never changes. `layout()` only overwrites vertices, and a frame
+ *   only rewrites their alpha, so text costs no allocation and no texture
+ *   upload during the fade.
+ * - Glyphs are scaled by an integer factor (`DisplayConfig::TEXT_ROWS` rows
+ *   fit the screen height) and sampled with nearest filtering, so the bitmap
+ *   font stays sharp at any resolution.
+ * - Lines longer than the box are cut; when there are more lines than fit,
+ *   the last visible one says how many were left out.
+ * - Needs SDL 2.0.18 or later (`SDL_RenderGeometry()`).
+ *
+ * Example usage:
+ * ```cpp
+ * TextOverlay text;
+ * text.load({renderer});
+ * text.layout("Action: add\nVendor: 046d\nProduct: c534");
+ * text.draw(0, 255); // after the background, before SDL_RenderPresent()
+ * ```
+ */
+class TextOverlay {
+public:
+    /// Longest text laid out, in visible glyphs.
+    static constexpr size_t MAX_GLYPHS = 1024;
+
+    TextOverlay();
+
+    /// @brief Frees the atlas textures.
+    ~TextOverlay();
+
+    TextOverlay(const TextOverlay&) = delete;
+    TextOverlay& operator=(const TextOverlay&) = delete;
+
+    /**
+     * @brief Builds the glyph atlas and the geometry buffers of every renderer.
+     * @param renderers One renderer per screen; `draw(i)` draws on `renderers[i]`.
+     * @return `true` if text can be drawn on at least one screen.
+     */
+    bool load(const std::vector<SDL_Renderer*>& renderers);
+
+    /// @brief Frees the atlases and buffers (before their renderers are destroyed).
+    void release();
+
+    /**
+     * @brief Lays `text` out for every screen; an empty or null text clears it.
+     *
+     * Lines are separated by `\n`; characters outside printable ASCII are
+     * shown as `?`.
+     */
+    void layout(const char* text);
+
+    /// @brief Draws the laid-out text on screen `screen` at opacity `alpha`.
+    void draw(size_t screen, uint8_t alpha);
+
+private:
+    /// Atlas and geometry of one screen (defined with the SDL types in the source).
+    struct Target;
+
+    std::vector<Target> targets; ///< Parallel to the renderers given to `load()`.
+    std::vector<int> indices;    ///< Two triangles per quad, shared by every target.
+
+    /// @brief Lays `text` out on one target.
+    void layoutTarget(Target& target, const char* text);
+};
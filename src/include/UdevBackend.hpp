@@ -0,0 +1,49 @@
+#pragma once
+#include "MonitorBackend.hpp"
+
+/**
+ * @class UdevBackend
+ * @brief `MonitorBackend` listening to udevd's processed events through libudev.
+ *
+ * Subscribes to the "udev" netlink group with a `usb/usb_device` filter.
+ * Events are delivered once udevd has finished running its rules, so the
+ * device node and sysfs attributes are guaranteed to be ready, at the cost
+ * of the rule processing delay.
+ *
+ * ## Design Notes
+ * - Uses **RAII** for `udev` and `udev_monitor` cleanup.
+ * - The monitor socket is non-blocking; `receive()` drains it completely.
+ * - `enumerate()` lists the devices already connected with `udev_enumerate`,
+ *   reading each device's properties once (its uevent file and udev record).
+ *
+ * ## Dependencies
+ * - libudev (Linux device manager)
+ */
+class UdevBackend : public MonitorBackend {
+public:
+    /// @brief Creates the udev context and enables the filtered monitor.
+    UdevBackend();
+
+    /// @brief Releases all libudev resources.
+    ~UdevBackend() override;
+
+    UdevBackend(const UdevBackend&) = delete;
+    UdevBackend& operator=(const UdevBackend&) = delete;
+
+    int fd() const override;
+    void receive(const Callback& onEvent) override;
+    size_t enumerate(const Callback& onDevice) override;
+    const char* name() const override { return "udev"; }
+
+    /**
+     * @brief Reports every connected `usb_device` as an "add" event.
+     * @param context  libudev context to use; a temporary one when `nullptr`.
+     * @param onDevice Called once per device.
+     * @return Number of devices found.
+     */
+    static size_t scanDevices(struct udev* context, const Callback& onDevice);
+
+private:
+    struct udev* udev;              ///< Pointer to the libudev context.
+    struct udev_monitor* mon;       ///< Pointer to the active udev monitor.
+};
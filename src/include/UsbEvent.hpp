@@ -1,55 +1,138 @@
 #pragma once
-#include <string>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
 
 /**
- * @class UsbEvent
+ * @enum UsbAction
+ * @brief Kernel uevent action of a `UsbEvent`.
+ */
+enum class UsbAction : uint8_t {
+    Unknown,
+    Add,
+    Remove,
+    Change,
+    Bind,
+    Unbind,
+};
+
+/**
+ * @struct UsbEvent
  * @brief Represents a high-level description of a USB device event.
  *
- * This class acts as a lightweight data container for USB plug/unplug events
- * detected by the system via **libudev**.
+ * This struct acts as a lightweight data container for USB plug/unplug events
+ * detected by the system via **libudev** or raw kernel uevents.
  *
  * ## Purpose
- * - Abstracts low-level udev device information into a readable form.
+ * - Abstracts low-level device information into a compact, typed form.
  * - Provides a uniform way for other modules (like `Notifier`) to access
  *   event metadata such as the device vendor, product ID, and node path.
  *
  * ## Design Notes
- * - Instances of this class are created by `UsbMonitor` whenever a new
- *   USB action is detected.
- * - This class is **immutable** after construction — its members are
- *   publicly accessible for convenience (since it’s a simple data struct).
- * - `toString()` is provided to format the event into a human-readable string,
- *   useful for logging or on-screen display.
+ * - Instances are created by the `MonitorBackend`s whenever a new USB action
+ *   is detected, then copied through the ring buffer and into batches.
+ * - **Trivially copyable**: IDs are parsed into integers and paths are stored
+ *   in fixed inline buffers, so creating, queueing and batching an event never
+ *   touches the heap. Paths longer than their buffer are truncated.
+ * - Nothing is formatted up front: `format()` and `formatId()` write into a
+ *   caller-provided buffer only when a log line or message is actually needed.
  */
-class UsbEvent {
-public:
-    /// The action performed on the device (e.g., "add", "remove").
-    std::string action;
+struct UsbEvent {
+    /// Capacity of `devnode`, including the terminating NUL ("/dev/bus/usb/001/004").
+    static constexpr size_t DEVNODE_CAPACITY = 32;
+    /// Capacity of `devpath`, including the terminating NUL.
+    static constexpr size_t DEVPATH_CAPACITY = 128;
+    /// Buffer size that always fits `formatId()` ("046d:c534").
+    static constexpr size_t ID_TEXT_SIZE = 10;
+
+    /// The action performed on the device.
+    UsbAction action = UsbAction::Unknown;
+
+    /// Vendor ID of the device (e.g., 0x046d).
+    uint16_t vendor = 0;
+
+    /// Product ID of the device (e.g., 0xc534).
+    uint16_t product = 0;
+
+    /// USB bus number (0 if unknown).
+    uint16_t busnum = 0;
+
+    /// Device number on its bus (0 if unknown).
+    uint16_t devnum = 0;
+
+    /// Kernel uevent sequence number (`SEQNUM`, 0 if unknown).
+    uint64_t seqnum = 0;
+
+    /// Monotonic time at which the kernel event was first handled (udev's
+    /// `USEC_INITIALIZED`); epoch (zero) if unknown.
+    std::chrono::steady_clock::time_point kernelAt;
+
+    /// Monotonic time at which the event was received from the backend.
+    std::chrono::steady_clock::time_point receivedAt;
+
+    /// Monotonic time at which the presentation thread dequeued the event.
+    std::chrono::steady_clock::time_point dequeuedAt;
 
-    /// Vendor ID of the device, as reported by udev (e.g., "046d").
-    std::string vendor;
+    /// The system device node, NUL-terminated (e.g., "/dev/bus/usb/001/004").
+    char devnode[DEVNODE_CAPACITY] = {};
 
-    /// Product ID of the device, as reported by udev (e.g., "c534").
-    std::string product;
+    /// The kernel device path, NUL-terminated (e.g., "/devices/pci0000:00/0000:00:14.0/usb1/1-2").
+    char devpath[DEVPATH_CAPACITY] = {};
 
-    /// The system device node (e.g., "/dev/bus/usb/001/004").
-    std::string devnode;
+    /// @brief Stamps `receivedAt` with the current monotonic time.
+    void stamp() { receivedAt = std::chrono::steady_clock::now(); }
+
+    /// @brief Copies `node` into `devnode`, truncating if needed.
+    void setDevnode(std::string_view node);
+
+    /// @brief Copies `path` into `devpath`, truncating if needed.
+    void setDevpath(std::string_view path);
 
     /**
-     * @brief Constructs a new UsbEvent with all device details.
-     * @param action  The type of event ("add" or "remove").
-     * @param vendor  The device vendor ID string.
-     * @param product The device product ID string.
-     * @param devnode The full device node path.
+     * @brief Sets `vendor` and `product` from a `PRODUCT` uevent property.
+     * @param property Value such as "46d/c534/1203" (vendor/product/bcdDevice in hex).
+     * @return `false` if the property is malformed; the IDs are left untouched.
      */
-    UsbEvent(const std::string& action,
-             const std::string& vendor,
-             const std::string& product,
-             const std::string& devnode);
+    bool setIds(std::string_view property);
 
     /**
-     * @brief Returns a formatted string containing all event details.
-     * @return A human-readable multi-line string describing the USB event.
+     * @brief Writes the event details, one field per line.
+     * @param buf  Destination buffer (always NUL-terminated when `size > 0`).
+     * @param size Size of `buf`.
+     * @return Number of characters written, excluding the NUL.
      */
-    std::string toString() const;
+    size_t format(char* buf, size_t size) const;
+
+    /// @brief Writes "vvvv:pppp" into `buf` (at least `ID_TEXT_SIZE` bytes).
+    void formatId(char* buf) const;
+
+    /// @brief 64-bit FNV-1a hash of `devpath`, a compact stand-in for the port.
+    uint64_t devpathHash() const;
+
+    /// @brief Parses an uevent action string ("add", "remove", ...).
+    static UsbAction parseAction(std::string_view action);
+
+    /// @brief Name of an action as used by uevents.
+    static const char* actionName(UsbAction action);
+
+    /**
+     * @brief Parses a hexadecimal ID ("046d" or "46d").
+     * @return `false` if `text` is empty, too long or not hexadecimal.
+     */
+    static bool parseHex(std::string_view text, uint16_t& out);
+
+    /// @brief Parses a decimal number such as BUSNUM ("001"); 0 on error.
+    static uint16_t parseDecimal(std::string_view text);
+
+    /// @brief Parses a 64-bit decimal number such as SEQNUM or USEC_INITIALIZED; 0 on error.
+    static uint64_t parseUnsigned(std::string_view text);
+
+    /// @brief Earliest known timestamp of the event: `kernelAt`, else `receivedAt`.
+    std::chrono::steady_clock::time_point originAt() const {
+        return kernelAt.time_since_epoch().count() ? kernelAt : receivedAt;
+    }
 };
+
+static_assert(std::is_trivially_copyable_v<UsbEvent>, "UsbEvent must stay trivially copyable");
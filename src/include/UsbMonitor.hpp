@@ -1,70 +1,158 @@
 #pragma once
 #include "UsbEvent.hpp"
+#include "EventLoop.hpp"
+#include "MonitorBackend.hpp"
+#include "DeviceIndex.hpp"
+#include "EventJournal.hpp"
+#include <chrono>
 #include <functional>
+#include <memory>
+#include <string>
 
 /**
  * @class UsbMonitor
- * @brief Continuously monitors the Linux system for USB plug/unplug events using libudev.
+ * @brief Continuously monitors the Linux system for USB plug events.
  *
  * This class serves as the **hardware event listener** for the entire application.
- * It interfaces directly with the Linux kernel's `udev` subsystem to detect
- * when USB devices are connected or disconnected.
+ * The actual event source is a `MonitorBackend`: either udevd's processed
+ * events (`UdevBackend`, the default) or raw kernel uevents
+ * (`NetlinkBackend`), selected by `MonitorConfig::USE_KERNEL_UEVENTS`.
  *
  * ## Responsibilities
- * - Initialize and configure a `udev_monitor` to listen for `usb_device` events.
- * - Block on the `udev` file descriptor using `select()` until an event occurs.
- * - Parse the event’s metadata (action, vendor ID, product ID, device node).
- * - Construct a `UsbEvent` object and forward it to the provided callback.
+ * - Create the configured backend (or take an injected one).
+ * - Register the backend's file descriptor on an `EventLoop` (epoll reactor).
+ * - Forward every added device reported by the backend to the provided callback.
+ * - Optionally (`journalEvents()`) record every event, removals included, in
+ *   an `EventJournal`.
+ * - Optionally (`trackDevices()`) report devices plugged while nobody was
+ *   listening, by comparing a scan of the connected devices with the last
+ *   known set.
  *
  * ## Design Notes
- * - Uses **RAII** for `udev` and `udev_monitor` cleanup.
- * - Operates in a **blocking loop**; this method is meant to run in the main thread.
- * - Only triggers callbacks for `"add"` (device plugged in) actions.
- * - Encapsulates all direct libudev interactions, isolating low-level details
- *   from higher-level application logic (`App` and `Notifier`).
+ * - Does not own a loop: events are delivered while the `EventLoop` it is
+ *   attached to runs, and monitoring stops cleanly with that loop. `App` runs
+ *   it on a dedicated intake thread, so callbacks must stay cheap (parse and
+ *   enqueue only).
+ * - Backends are non-blocking; each wakeup drains every pending device.
+ * - Backends report every action; only `"add"` (device plugged in) reaches
+ *   the callback, the others are journaled and keep the device index current.
+ * - Isolates low-level event sources from higher-level application logic
+ *   (`App` and `Notifier`).
+ *
+ * ## Reconciliation
+ * Live netlink events miss devices plugged while the daemon restarts or the
+ * machine sleeps. With `trackDevices()`:
+ * - `startMonitoring()` enumerates the connected devices once
+ *   (`MonitorBackend::enumerate()`) into a `DeviceIndex` and reports those
+ *   missing from the snapshot persisted by the previous run (and journals
+ *   them with `JournalRecord::FLAG_SCANNED`). Without a
+ *   snapshot (first run) nothing is reported, the set is only recorded.
+ * - `reconcile()` (after resume) rescans and reports devices missing from
+ *   the index, which also tracks every device added or removed live since.
+ * - The socket is watched before scanning, so nothing falls in between; live
+ *   events for devices a scan just reported are dropped for
+ *   `MonitorConfig::RECONCILE_DEDUPE_MS`, so no device alerts twice.
+ * - `saveSnapshot()` rescans and persists the set at shutdown.
  *
  * ## Usage Example
  * ```cpp
+ * EventLoop loop;
  * UsbMonitor monitor;
- * monitor.startMonitoring([](const UsbEvent& e) {
- *     std::cout << e.toString() << std::endl;
+ * monitor.startMonitoring(loop, [](const UsbEvent& e) {
+ *     char text[256];
+ *     e.format(text, sizeof(text));
+ *     std::cout << text << std::endl;
  * });
+ * loop.run();
  * ```
  *
  * ## Dependencies
- * - libudev (Linux device manager)
- * - Standard C headers: `<sys/select.h>` for polling file descriptors
+ * - `MonitorBackend` implementations (libudev or kernel netlink)
+ * - `EventLoop` for readiness notification
  */
 class UsbMonitor {
 public:
     /// Type alias for the event callback function.
-    using Callback = std::function<void(const UsbEvent&)>;
+    using Callback = MonitorBackend::Callback;
 
     /**
-     * @brief Constructs and initializes the udev monitoring context.
-     * 
-     * Prepares the libudev monitor to capture `usb_device` events.
+     * @brief Constructs the backend selected by `MonitorConfig`.
      */
     UsbMonitor();
 
     /**
-     * @brief Releases all libudev resources.
-     *
-     * Called automatically when the monitor object is destroyed.
+     * @brief Constructs a monitor on an explicit backend.
+     * @param backend Event source to use (benchmarks, alternative sources);
+     *                the configured one when `nullptr`.
      */
-    ~UsbMonitor();
+    explicit UsbMonitor(std::unique_ptr<MonitorBackend> backend);
 
     /**
-     * @brief Begins continuous USB event monitoring.
+     * @brief Begins USB event monitoring on an event loop.
      *
-     * Blocks the calling thread, waiting for incoming events.
-     * Each time a new USB device is added, the provided callback is executed.
+     * Registers the backend socket on `loop`; each time a new USB device is
+     * added while the loop runs, the provided callback is executed.
      *
+     * @param loop    Loop that will watch the backend socket.
      * @param onEvent Function to call when a USB event is detected.
+     * @return `true` if the monitor was registered.
+     */
+    bool startMonitoring(EventLoop& loop, Callback onEvent);
+
+    /**
+     * @brief Reads every pending event without blocking.
+     * @param onEvent Function to call for each added USB device.
+     */
+    void receive(const Callback& onEvent);
+
+    /// @brief The backend socket (for custom polling).
+    int fd() const;
+
+    /// @brief Name of the active backend ("udev" or "kernel").
+    const char* backendName() const;
+
+    /**
+     * @brief Enables reconciliation against a snapshot file; call before `startMonitoring()`.
+     * @param snapshotPath Where the last known device set is kept.
+     */
+    void trackDevices(std::string snapshotPath);
+
+    /**
+     * @brief Records every event in a journal file; call before `startMonitoring()`.
+     * @return `false` if the journal could not be opened (monitoring works regardless).
+     */
+    bool journalEvents(const std::string& path, uint32_t capacity);
+
+    /**
+     * @brief Rescans and reports devices missing from the index (e.g. after resume).
+     *
+     * Must run on the thread of the loop given to `startMonitoring()`.
+     * @return Number of devices reported.
+     */
+    size_t reconcile();
+
+    /**
+     * @brief Rescans and persists the connected devices (e.g. at shutdown).
+     * @return `true` if the snapshot was written.
      */
-    void startMonitoring(const Callback& onEvent);
+    bool saveSnapshot();
 
 private:
-    struct udev* udev;              ///< Pointer to the libudev context.
-    struct udev_monitor* mon;       ///< Pointer to the active udev monitor.
+    std::unique_ptr<MonitorBackend> backend; ///< Active event source.
+    Callback callback;                       ///< Receiver given to `startMonitoring()`.
+    std::string snapshotPath;                ///< Snapshot file; empty when not tracking.
+    DeviceIndex known;                       ///< Devices scanned or seen live this run.
+    DeviceIndex lastScan;                    ///< Devices of the latest scan, for de-duplication.
+    std::chrono::steady_clock::time_point dedupeUntil; ///< End of the de-duplication window.
+    EventJournal journal;                    ///< Audit log; closed unless `journalEvents()` was called.
+
+    /**
+     * @brief Scans the connected devices and reports those `previous` lacks.
+     * @param previous Reference set; `nullptr` records the scan without reporting.
+     * @param sameBoot Whether `previous` was taken during this boot.
+     */
+    size_t rescan(const DeviceIndex* previous, bool sameBoot);
+
+    /// @brief Records a live "add" event; `false` if a recent scan already reported it.
+    bool admit(const UsbEvent& event);
 };
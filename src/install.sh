@@ -26,13 +26,14 @@ if [ -f /etc/debian_version ]; then
         libsdl2-image-2.0-0 \
         libsdl2-mixer-2.0-0 \
         libudev1 \
-        pulseaudio-utils
+        libsystemd0 \
+        libpulse0
 elif [ -f /etc/redhat-release ]; then
-    sudo dnf install -y SDL2 SDL2_image SDL2_mixer systemd-libs pulseaudio-utils
+    sudo dnf install -y SDL2 SDL2_image SDL2_mixer systemd-libs pulseaudio-libs
 elif [ -f /etc/arch-release ]; then
-    sudo pacman -Sy --noconfirm sdl2 sdl2_image sdl2_mixer systemd-libs pulseaudio-utils
+    sudo pacman -Sy --noconfirm sdl2 sdl2_image sdl2_mixer systemd-libs libpulse
 else
-    echo "⚠️ Unsupported distribution. Please manually install SDL2, SDL2_image, SDL2_mixer, libudev, and pulseaudio-utils."
+    echo "⚠️ Unsupported distribution. Please manually install SDL2, SDL2_image, SDL2_mixer, libudev, libsystemd, and libpulse."
 fi
 
 # ⏹️ 2️⃣ Stop any existing instance
@@ -62,6 +63,14 @@ if [ ! -f "$BINARY_PATH" ]; then
 fi
 
 sudo cp -f "$BINARY_PATH" "$INSTALL_DIR/"
+for TOOL in journal ctl; do
+    TOOL_PATH="$BASE_DIR/bin/$APP_NAME-$TOOL"
+    if [ -f "$TOOL_PATH" ]; then
+        sudo cp -f "$TOOL_PATH" "$INSTALL_DIR/"
+    else
+        echo "⚠️ Missing tool: $TOOL_PATH"
+    fi
+done
 if [ -f "$IMG_PATH" ]; then
     sudo cp -f "$IMG_PATH" "$INSTALL_DIR/background.png"
 else
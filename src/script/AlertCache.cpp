@@ -0,0 +1,175 @@
+#include "../include/AlertCache.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <filesystem>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char MAGIC[8] = {'U', 'S', 'B', 'M', 'A', 'L', '0', '1'};
+
+    /// Entry header; samples start right after it.
+    struct FileHeader {
+        char magic[8];
+        uint64_t sourceHash;
+        double targetLufs;
+        double ceilingDbfs;
+        double maxGainDb;
+        double maxLimitingDb;
+        double sourceLufs;
+        double sourcePeakDbfs;
+        double gainDb;
+        uint64_t sampleBytes;
+        uint32_t frequency;
+        uint32_t channels;
+        uint16_t format;
+        uint8_t kernel;
+        uint8_t reserved[37];
+    };
+    static_assert(sizeof(FileHeader) == 128, "cache header must stay 128 bytes");
+
+    // The name only needs to tell targets apart; the header holds the exact values
+    uint32_t targetHash(const LoudnessTarget& target) {
+        uint64_t h = 0x9E3779B97F4A7C15ull;
+        for (double value : {target.loudnessLufs, target.ceilingDbfs, target.maxGainDb, target.maxLimitingDb}) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            h = (h ^ bits) * 0xFF51AFD7ED558CCDull;
+            h ^= h >> 32;
+        }
+        return static_cast<uint32_t>(h);
+    }
+
+    bool sameTarget(const FileHeader& header, const LoudnessTarget& target) {
+        return header.targetLufs == target.loudnessLufs && header.ceilingDbfs == target.ceilingDbfs &&
+               header.maxGainDb == target.maxGainDb && header.maxLimitingDb == target.maxLimitingDb;
+    }
+
+    bool writeAll(int fd, const void* data, size_t size) {
+        const char* p = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t n = write(fd, p, size);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            p += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+}
+
+MappedSound::~MappedSound() {
+    if (mapping) munmap(mapping, length);
+}
+
+MappedSound::MappedSound(MappedSound&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedSound& MappedSound::operator=(MappedSound&& other) noexcept {
+    if (this != &other) {
+        if (mapping) munmap(mapping, length);
+        loudness = other.loudness;
+        mapping = std::exchange(other.mapping, nullptr);
+        length = std::exchange(other.length, 0);
+        sampleData = std::exchange(other.sampleData, nullptr);
+        sampleLength = std::exchange(other.sampleLength, 0);
+    }
+    return *this;
+}
+
+AlertCache::AlertCache(std::string dir)
+    : directory(std::move(dir)) {}
+
+std::string AlertCache::pathFor(const Key& key) const {
+    char name[112];
+    std::snprintf(name, sizeof(name), "/alert-%016llx-%d-%04x-%dch-%08x.pcm",
+                  static_cast<unsigned long long>(key.sourceHash), key.frequency, key.format, key.channels,
+                  targetHash(key.target));
+    return directory + name;
+}
+
+MappedSound AlertCache::open(const Key& key) const {
+    MappedSound sound;
+    std::string path = pathFor(key);
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return sound;
+
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) > sizeof(FileHeader))
+        data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return sound;
+
+    sound.mapping = data;
+    sound.length = static_cast<size_t>(st.st_size);
+
+    // A file that does not match its own name is treated as a miss
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.sourceHash != key.sourceHash ||
+        header.frequency != static_cast<uint32_t>(key.frequency) || header.format != key.format ||
+        header.channels != static_cast<uint32_t>(key.channels) || !sameTarget(header, key.target) ||
+        header.kernel > static_cast<uint8_t>(LoudnessNormalizer::Kernel::AVX2) ||
+        sound.length != sizeof(FileHeader) + header.sampleBytes) {
+        std::cerr << "⚠️ Ignoring corrupt alert cache entry: " << path << "\n";
+        return MappedSound{};
+    }
+
+    sound.sampleData = static_cast<char*>(data) + sizeof(FileHeader);
+    sound.sampleLength = static_cast<size_t>(header.sampleBytes);
+    sound.loudness.source.loudnessLufs = header.sourceLufs;
+    sound.loudness.source.peakDbfs = header.sourcePeakDbfs;
+    sound.loudness.gainDb = header.gainDb;
+    sound.loudness.kernel = static_cast<LoudnessNormalizer::Kernel>(header.kernel);
+    return sound;
+}
+
+bool AlertCache::store(const Key& key, const void* samples, size_t bytes,
+                       const LoudnessNormalizer::Result& loudness) const {
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+
+    std::string path = pathFor(key);
+    std::string temp = path + ".tmp." + std::to_string(getpid());
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "⚠️ Alert cache not writable: " << directory << " | " << strerror(errno) << "\n";
+        return false;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.sourceHash = key.sourceHash;
+    header.targetLufs = key.target.loudnessLufs;
+    header.ceilingDbfs = key.target.ceilingDbfs;
+    header.maxGainDb = key.target.maxGainDb;
+    header.maxLimitingDb = key.target.maxLimitingDb;
+    header.sourceLufs = loudness.source.loudnessLufs;
+    header.sourcePeakDbfs = loudness.source.peakDbfs;
+    header.gainDb = loudness.gainDb;
+    header.sampleBytes = bytes;
+    header.frequency = static_cast<uint32_t>(key.frequency);
+    header.channels = static_cast<uint32_t>(key.channels);
+    header.format = key.format;
+    header.kernel = static_cast<uint8_t>(loudness.kernel);
+
+    bool ok = writeAll(fd, &header, sizeof(header)) && writeAll(fd, samples, bytes);
+    ok = close(fd) == 0 && ok;
+    if (!ok || rename(temp.c_str(), path.c_str()) < 0) {
+        std::cerr << "⚠️ Could not store alert cache entry: " << strerror(errno) << "\n";
+        unlink(temp.c_str());
+        return false;
+    }
+    return true;
+}
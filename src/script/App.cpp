@@ -2,12 +2,449 @@
 #include "../include/UsbMonitor.hpp"
 #include "../include/Notifier.hpp"
 #include "../include/UsbEvent.hpp"
+#include "../include/Config.hpp"
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <malloc.h>
+#include <signal.h>
+#include <unistd.h>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <chrono>
+
+App::App(std::unique_ptr<MonitorBackend> backend)
+    : monitor(std::move(backend)),
+      config(RuntimeConfig::load(UserConfig::getConfigPath(), UserConfig::getRulesPath())),
+      coalescer(std::chrono::milliseconds(PipelineConfig::COALESCE_WINDOW_MS),
+                PipelineConfig::MAX_BATCH_SIZE) {
+    wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    commandFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFd < 0 || commandFd < 0) {
+        std::cerr << "❌ eventfd creation failed: " << strerror(errno) << "\n";
+    }
+}
+
+App::~App() {
+    if (wakeFd >= 0) close(wakeFd);
+    if (commandFd >= 0) close(commandFd);
+}
+
+void App::enqueue(const UsbEvent& event) {
+    if (event.kernelAt.time_since_epoch().count())
+        tracer.record(TraceStage::Udev, event.receivedAt - event.kernelAt);
+
+    // Ignored devices never reach the limiter, the queue or the log
+    if (config.read(INTAKE_READER)->rules.match(event).kind == RuleAction::Kind::Ignore) return;
+
+    // Over-limit and quarantined events are counted by the limiter, never queued
+    if (limiter.allow(event) != RateLimiter::Verdict::Allow) return;
+
+    if (!queue.push(event)) {
+        char id[UsbEvent::ID_TEXT_SIZE];
+        event.formatId(id);
+        std::cerr << "⚠️ Event queue full, dropped: " << id << "\n";
+        return;
+    }
+
+    uint64_t one = 1;
+    if (write(wakeFd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        std::cerr << "⚠️ Could not wake presentation thread: " << strerror(errno) << "\n";
+    }
+}
+
+void App::drainQueue() {
+    UsbEvent event;
+    while (queue.pop(event)) {
+        event.dequeuedAt = std::chrono::steady_clock::now();
+        tracer.record(TraceStage::Intake, event.dequeuedAt - event.receivedAt);
+        coalescer.add(event);
+    }
+    // Rebuild a released engine now, while the coalescing window runs
+    if (coalescer.pending()) prewarm();
+}
+
+void App::schedule() {
+    // A batch closing during a fade replaces the alert on screen
+    if (!coalescer.pending()) return;
+
+    auto now = std::chrono::steady_clock::now();
+    if (coalescer.due(now)) {
+        presentLoop.disarmTimer(coalesceTimer);
+
+        // The engine is still being rebuilt off the loop: finishPrewarm() serves the batch
+        if (notifier.isWarming()) return;
+        notifyBatch();
+    } else {
+        presentLoop.armTimer(coalesceTimer, coalescer.deadline() - now);
+    }
+}
+
+void App::notifyBatch() {
+    const UsbEventBatch& batch = coalescer.take();
+    auto settings = config.read(PRESENT_READER);
+
+    // The first device that wants an alert decides its look; silent devices were logged already
+    const RuleAction* rule = nullptr;
+    for (const UsbEvent& event : batch.events) {
+        const RuleAction& action = settings->rules.match(event);
+        if (action.kind == RuleAction::Kind::Alert) {
+            rule = &action;
+            break;
+        }
+    }
+
+    batch.format(message, sizeof(message));
+    if (!rule) {
+        std::cout << "🔕 " << batch.count() << " device(s) silenced by rules\n";
+    } else if (muted()) {
+        std::cout << "🔇 " << batch.count() << " device(s) not shown, alerts are muted\n";
+    } else {
+        // No-op unless a reload changed the assets while an alert was on screen
+        notifier.configureAssets(settings->assets, settings->rules.assetSets());
+
+        AlertStyle style;
+        style.assetSet = rule->assetSet;
+        style.fadeDelayMs = rule->fadeDelayMs >= 0 ? rule->fadeDelayMs : settings->fadeDelayMs;
+        style.fadeSpeed = rule->fadeSpeed > 0 ? rule->fadeSpeed : settings->fadeSpeed;
+        style.frameDelayMs = rule->frameDelayMs > 0 ? rule->frameDelayMs : settings->frameDelayMs;
+        style.volumePercent = settings->volumePercent;
+        style.priority = rule->priority;
+
+        // The alert on screen, if any, stops here; its sound plays on
+        alertCancel.cancel();
+        if (notifier.begin("Anime Girl Moaning noices", message, batch.firstReceivedAt, style)) {
+            fadeAlert(std::chrono::milliseconds(style.fadeDelayMs), alertCancel.token());
+
+            // The batch is traced through the event that opened it
+            const UsbEvent& trigger = batch.events.front();
+            const AlertTiming& timing = notifier.alertTiming();
+            tracer.record(TraceStage::Scheduling, timing.shownAt - trigger.dequeuedAt);
+            tracer.record(TraceStage::FirstFrame, timing.firstFrameAt - timing.shownAt);
+            tracer.record(TraceStage::PlugToPixel, timing.firstFrameAt - trigger.originAt());
+            alertOrigin = trigger.originAt();
+            alertShownAt = timing.shownAt;
+            awaitingAudio = true;
+        }
+    }
+
+    QueueStats stats = queue.stats();
+    RateLimiterStats limits = limiter.stats();
+    armIdle();
+    std::cout << "📊 Notified " << batch.count() << " device(s); queue depth " << stats.depth
+              << ", high-water " << stats.highWater << ", dropped " << stats.dropped
+              << "; rate-limited " << limits.suppressed() << ", quarantined devices "
+              << limits.quarantinedDevices << "\n";
+}
+
+Task App::fadeAlert(std::chrono::milliseconds hold, CancelToken cancel) {
+    // Hold full opacity, then one tick per frame until the overlay is hidden
+    LoopTimer frames(presentLoop);
+    frames.start(hold, notifier.frameInterval());
+    while (co_await frames.tick(cancel)) {
+        if (notifier.advanceFade()) continue;
+
+        // Fade finished: serve whatever piled up meanwhile
+        armIdle();
+        schedule();
+        co_return;
+    }
+    if (cancel.cancelled()) co_return;
+
+    // No frame timer (timerfd creation failed): hide the overlay now instead of until the next alert
+    std::cerr << "⚠️ Fade timer unavailable, overlay hidden without fading.\n";
+    notifier.finish();
+    armIdle();
+    schedule();
+}
+
+void App::onAudio() {
+    notifier.onAudioFinished();
+
+    std::chrono::steady_clock::time_point firstBuffer;
+    if (notifier.takeFirstAudio(firstBuffer) && awaitingAudio) {
+        tracer.record(TraceStage::FirstAudio, firstBuffer - alertShownAt);
+        tracer.record(TraceStage::PlugToSound, firstBuffer - alertOrigin);
+        awaitingAudio = false;
+    }
+}
+
+void App::armIdle() {
+    int seconds = config.read(PRESENT_READER)->idleReleaseSec;
+    if (seconds > 0) presentLoop.armTimer(idleTimer, std::chrono::seconds(seconds));
+    else presentLoop.disarmTimer(idleTimer);
+}
+
+void App::releaseIdle() {
+    if (!notifier.isReady()) return;
+    if (notifier.isFading() || notifier.playingVoices() > 0 || coalescer.pending()) {
+        armIdle();
+        return;
+    }
+
+    size_t before = IdleTracker::residentBytes();
+    notifier.shutdown();
+    malloc_trim(0);
+    idle.enter(IdleTracker::State::Idle, wakeups());
+    idleNow.store(true, std::memory_order_relaxed);
+    std::cout << "💤 Idle: presentation engine released, RSS " << before / 1024 << " KiB → "
+              << idle.usage(IdleTracker::State::Idle).rssBytes / 1024 << " KiB\n";
+}
+
+void App::prewarm() {
+    if (notifier.isReady() || notifier.isWarming()) return;
+
+    // Audio settings changed while idle apply now, the device is opened anew
+    {
+        auto settings = config.read(PRESENT_READER);
+        notifier.configureAudio(settings->audioBufferSamples, settings->voices);
+    }
+    prewarmStartedAt = std::chrono::steady_clock::now();
+    if (!notifier.startInit()) return;
+    prewarmOnLoop = std::chrono::steady_clock::now() - prewarmStartedAt;
+
+    // Built synchronously after all (no eventfd): nothing to wait for
+    if (notifier.isReady()) finishPrewarm();
+}
+
+void App::finishPrewarm() {
+    if (!notifier.completeInit()) return;
+
+    if (idle.state() == IdleTracker::State::Idle) {
+        idle.enter(IdleTracker::State::Active, wakeups());
+        idleNow.store(false, std::memory_order_relaxed);
+        auto ms = [](std::chrono::steady_clock::duration d) {
+            return std::chrono::duration<double, std::milli>(d).count();
+        };
+        std::cout << "☀️ Presentation engine prewarmed in " << ms(std::chrono::steady_clock::now() - prewarmStartedAt)
+                  << " ms (" << ms(prewarmOnLoop) << " ms on the loop), RSS "
+                  << idle.usage(IdleTracker::State::Active).rssBytes / 1024 << " KiB\n";
+    }
+
+    // A reload during the rebuild was left for now; then serve the batch that waited for audio
+    applyAssets();
+    armIdle();
+    schedule();
+}
+
+uint64_t App::wakeups() const {
+    return intakeLoop.wakeups() + presentLoop.wakeups() + controlLoop.wakeups();
+}
+
+void App::reportLatency() {
+    std::cout << "⏱️ Plug-to-alert latency:\n";
+    tracer.dump(std::cout);
+    std::cout << "🔋 Resource states:\n";
+    idle.report(std::cout, wakeups());
+
+    std::string path = TraceConfig::getStatsPath();
+    if (!tracer.writeFile(path)) {
+        std::cerr << "⚠️ Could not write latency stats: " << path << " | " << strerror(errno) << "\n";
+    }
+}
+
+bool App::reloadConfig() {
+    uint64_t version = config.publish(
+        RuntimeConfig::load(UserConfig::getConfigPath(), UserConfig::getRulesPath()));
+    std::cout << "🔧 Configuration v" << version << " published\n";
+
+    // Decode changed assets now if nothing is on screen; otherwise the next alert (or the rebuild) picks them up
+    bool rebuilt = !notifier.isFading() && !notifier.isWarming() && applyAssets();
+    if (notifier.isReady()) armIdle();
+    return rebuilt;
+}
+
+bool App::applyAssets() {
+    auto settings = config.read(PRESENT_READER);
+    return notifier.configureAssets(settings->assets, settings->rules.assetSets());
+}
+
+bool App::muted() const {
+    int64_t now = std::chrono::system_clock::now().time_since_epoch() / std::chrono::nanoseconds(1);
+    return mutedUntil.load(std::memory_order_relaxed) > now;
+}
+
+bool App::submit(const ControlCommand& command) {
+    if (!commands.push(command)) return false;
+    uint64_t one = 1;
+    return write(commandFd, &one, sizeof(one)) >= 0 || errno == EAGAIN;
+}
+
+void App::drainCommands() {
+    ControlCommand command;
+    while (commands.pop(command)) {
+        if (command.kind == ControlCommand::Kind::Reload) {
+            std::cout << "🔄 Reload requested over the control socket\n";
+            // Changed paths were just decoded from scratch; only unchanged ones need a fresh read
+            if (!reloadConfig()) notifier.reloadAssets();
+            continue;
+        }
+        UsbEvent& event = command.event;
+        if (config.read(PRESENT_READER)->rules.match(event).kind == RuleAction::Kind::Ignore) continue;
+        event.dequeuedAt = std::chrono::steady_clock::now();
+        coalescer.add(event);
+    }
+    if (coalescer.pending()) prewarm();
+    schedule();
+}
+
+void App::onControl(std::string_view request, std::string& reply) {
+    size_t space = request.find(' ');
+    std::string_view command = request.substr(0, space);
+    std::string_view argument = space == std::string_view::npos ? std::string_view() : request.substr(space + 1);
+
+    if (command == "stats") {
+        QueueStats stats = queue.stats();
+        RateLimiterStats limits = limiter.stats();
+        int64_t now = std::chrono::system_clock::now().time_since_epoch() / std::chrono::nanoseconds(1);
+        int64_t mutedNs = mutedUntil.load(std::memory_order_relaxed) - now;
+
+        std::ostringstream out;
+        out << "ok\nqueue depth " << stats.depth << ", high-water " << stats.highWater << ", pushed "
+            << stats.pushed << ", dropped " << stats.dropped << "\nrate-limited " << limits.suppressed()
+            << " (device " << limits.deviceLimited << ", global " << limits.globalLimited << ", quarantine "
+            << limits.quarantineDrops << "), quarantined devices " << limits.quarantinedDevices << "\n";
+        if (mutedNs > 0) out << "muted for " << (mutedNs / 1000000000 + 59) / 60 << " min\n";
+        else out << "not muted\n";
+        out << (idleNow.load(std::memory_order_relaxed) ? "idle" : "active") << ", rss "
+            << IdleTracker::residentBytes() / 1024 << " KiB, " << wakeups() << " loop wakeups\n";
+        tracer.dump(out);
+        reply = out.str();
+    } else if (command == "inject") {
+        // "inject vvvv:pppp [devpath]"
+        std::string_view ids = argument.substr(0, argument.find(' '));
+        std::string_view devpath = ids.size() < argument.size() ? argument.substr(ids.size() + 1) : "/control/inject";
+        size_t colon = ids.find(':');
+        ControlCommand injected;
+        UsbEvent& event = injected.event;
+        if (colon == std::string_view::npos || !UsbEvent::parseHex(ids.substr(0, colon), event.vendor) ||
+            !UsbEvent::parseHex(ids.substr(colon + 1), event.product)) {
+            reply = "error usage: inject vvvv:pppp [devpath]";
+            return;
+        }
+        event.stamp();
+        event.action = UsbAction::Add;
+        event.setDevpath(devpath);
+        reply = submit(injected) ? "ok injected" : "error busy";
+    } else if (command == "mute") {
+        int minutes = 0;
+        auto parsed = std::from_chars(argument.data(), argument.data() + argument.size(), minutes);
+        if (parsed.ec != std::errc() || parsed.ptr != argument.data() + argument.size() || minutes <= 0 ||
+            minutes > ControlConfig::MAX_MUTE_MINUTES) {
+            reply = "error usage: mute <minutes>, 1-" + std::to_string(ControlConfig::MAX_MUTE_MINUTES);
+            return;
+        }
+        auto until = std::chrono::system_clock::now() + std::chrono::minutes(minutes);
+        mutedUntil.store(until.time_since_epoch() / std::chrono::nanoseconds(1), std::memory_order_relaxed);
+        std::cout << "🔇 Alerts muted for " << minutes << " min\n";
+        reply = "ok muted for " + std::to_string(minutes) + " min";
+    } else if (command == "unmute") {
+        mutedUntil.store(0, std::memory_order_relaxed);
+        std::cout << "🔔 Alerts unmuted\n";
+        reply = "ok unmuted";
+    } else if (command == "reload") {
+        ControlCommand reload;
+        reload.kind = ControlCommand::Kind::Reload;
+        reply = submit(reload) ? "ok reloading" : "error busy";
+    } else {
+        reply = "error unknown command; try stats, inject, mute, unmute, reload";
+    }
+}
+
+void App::onSignal(int signo) {
+    if (signo == SIGUSR1) {
+        reportLatency();
+        return;
+    }
+    if (signo == SIGHUP) {
+        std::cout << "🔄 SIGHUP received, reloading configuration and assets\n";
+        if (!reloadConfig()) notifier.reloadAssets();
+        return;
+    }
+
+    std::cout << "👋 " << strsignal(signo) << " received, shutting down\n";
+    stop();
+}
+
+void App::stop() {
+    intakeLoop.stop();
+    presentLoop.stop();
+    controlLoop.stop();
+}
 
 void App::run() {
-    UsbMonitor monitor;
-    Notifier notifier;
+    if (wakeFd < 0 || commandFd < 0) return;
 
-    monitor.startMonitoring([&notifier](const UsbEvent& event) {
-        notifier.showMessage("Anime Girl Moaning noices", event.toString());
+    // Route signals to the presentation loop before any thread is spawned
+    presentLoop.watchSignals({SIGTERM, SIGINT, SIGHUP, SIGUSR1}, [this](int signo) { onSignal(signo); });
+    coalesceTimer = presentLoop.addTimer([this]() { schedule(); });
+    idleTimer = presentLoop.addTimer([this]() { releaseIdle(); });
+    presentLoop.watch(wakeFd, EPOLLIN, [this](uint32_t) {
+        // Reset the eventfd counter; the queue itself tells how many events wait
+        uint64_t pending = 0;
+        if (read(wakeFd, &pending, sizeof(pending)) < 0) return;
+        drainQueue();
+        schedule();
+    });
+    presentLoop.watch(notifier.audioFd(), EPOLLIN, [this](uint32_t) { onAudio(); });
+    if (notifier.warmupFd() >= 0)
+        presentLoop.watch(notifier.warmupFd(), EPOLLIN, [this](uint32_t) { finishPrewarm(); });
+    presentLoop.watch(commandFd, EPOLLIN, [this](uint32_t) {
+        uint64_t pending = 0;
+        if (read(commandFd, &pending, sizeof(pending)) < 0) return;
+        drainCommands();
     });
+
+    // Config edits are picked up on this loop; readers keep going lock-free
+    configWatcher.start(presentLoop, UserConfig::getConfigDir(),
+                        {UserConfig::CONFIG_FILE, UserConfig::RULES_FILE},
+                        std::chrono::milliseconds(UserConfig::RELOAD_DEBOUNCE_MS),
+                        [this]() { reloadConfig(); });
+    applyAssets();
+    {
+        auto settings = config.read(PRESENT_READER);
+        notifier.configureAudio(settings->audioBufferSamples, settings->voices);
+    }
+
+    // Build the presentation engine once; alerts only show and hide its window
+    if (!notifier.init()) {
+        std::cerr << "⚠️ Presentation engine not ready, retrying on next event.\n";
+    }
+    idle.start(wakeups());
+    armIdle();
+
+    // Intake thread: drain udev and hand events over without ever blocking on display.
+    // Devices plugged while stopped are reported right away, on this thread, before it starts
+    if (JournalConfig::ENABLED) monitor.journalEvents(JournalConfig::getJournalPath(), JournalConfig::CAPACITY);
+    if (MonitorConfig::RECONCILE_DEVICES) {
+        monitor.trackDevices(MonitorConfig::getSnapshotPath());
+        sleepWatcher.start(intakeLoop, [this](bool sleeping) {
+            if (!sleeping) monitor.reconcile();
+        });
+    }
+    monitor.startMonitoring(intakeLoop, [this](const UsbEvent& event) { enqueue(event); });
+    std::thread intake([this]() { intakeLoop.run(); });
+
+    // Control thread: clients are served away from both the intake and the presentation loops
+    if (ControlConfig::ENABLED) {
+        control.start(controlLoop, ControlConfig::getSocketPath(),
+                      [this](std::string_view request, std::string& reply) { onControl(request, reply); });
+    }
+    std::thread controller([this]() { controlLoop.run(); });
+
+    // SDL video stays on the main thread, which becomes the presentation thread
+    presentLoop.run();
+
+    controlLoop.stop();
+    controller.join();
+    intakeLoop.stop();
+    intake.join();
+    monitor.saveSnapshot();
+    reportLatency();
+    alertCancel.cancel();
+    notifier.shutdown();
 }
@@ -0,0 +1,282 @@
+#include "../include/AssetCache.hpp"
+#include "../include/Config.hpp"
+#include "../include/ImageScaler.hpp"
+#include "../include/LoudnessNormalizer.hpp"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <iostream>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+namespace fs = std::filesystem;
+
+AssetCache::~AssetCache() {
+    release();
+}
+
+bool AssetCache::load(const std::vector<SDL_Renderer*>& targets) {
+    bool images = loadImages(targets);
+    bool sound = loadSound();
+    logFootprint();
+    return images || sound;
+}
+
+bool AssetCache::loadImages(const std::vector<SDL_Renderer*>& targets) {
+    releaseImages();
+    renderers = targets;
+    loadBackgrounds(paths.background.empty() ? DisplayConfig::getBackgroundPath() : paths.background);
+    return std::any_of(backgrounds.begin(), backgrounds.end(),
+                       [](const Background& bg) { return bg.texture != nullptr; });
+}
+
+bool AssetCache::loadSound() {
+    releaseSound();
+    loadAlert(paths.sound.empty() ? AudioConfig::getSoundPath() : paths.sound);
+    return chunk != nullptr;
+}
+
+void AssetCache::logFootprint() const {
+    AssetFootprint fp = footprint();
+    std::cout << "🗃️ Asset cache: " << fp.surfaceBytes / 1024 << " KiB surface, "
+              << fp.textureBytes / 1024 << " KiB texture, "
+              << fp.pcmBytes / 1024 << " KiB PCM\n";
+}
+
+bool AssetCache::reload() {
+    return load(renderers);
+}
+
+namespace {
+    // Screens with the same size and format can share one resampled image
+    bool sameTarget(const BackgroundCache::Key& a, const BackgroundCache::Key& b) {
+        return a.width == b.width && a.height == b.height && a.format == b.format;
+    }
+
+    // Resamples the shared RGBA source for one screen; touches no video state, so it runs off the main thread
+    SDL_Surface* scaleFor(SDL_Surface* rgba, Uint32 format, int width, int height) {
+        // The kernel writes the common 32-bit GPU formats directly; anything else goes through SDL afterwards
+        ImageScaler::PixelLayout layout;
+        Uint32 kernelFormat = format;
+        if (SDL_BYTEORDER == SDL_LIL_ENDIAN && format == SDL_PIXELFORMAT_ARGB8888) layout = {true, false};
+        else if (SDL_BYTEORDER == SDL_LIL_ENDIAN && format == SDL_PIXELFORMAT_RGB888) layout = {true, true};
+        else if (SDL_BYTEORDER == SDL_LIL_ENDIAN && format == SDL_PIXELFORMAT_BGR888) layout = {false, true};
+        else if (format != SDL_PIXELFORMAT_RGBA32) kernelFormat = SDL_PIXELFORMAT_RGBA32;
+
+        SDL_Surface* scaled = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, kernelFormat);
+        if (!scaled) return nullptr;
+        ImageScaler(rgba->w, rgba->h, width, height).scale(
+            static_cast<const uint8_t*>(rgba->pixels), rgba->pitch,
+            static_cast<uint8_t*>(scaled->pixels), scaled->pitch, layout);
+
+        if (kernelFormat != format) {
+            SDL_Surface* converted = SDL_ConvertSurfaceFormat(scaled, format, 0);
+            SDL_FreeSurface(scaled);
+            scaled = converted;
+        }
+        return scaled;
+    }
+}
+
+void AssetCache::loadBackgrounds(const std::string& path) {
+    backgrounds.clear();
+    backgrounds.resize(renderers.size());
+    if (!fs::exists(path)) {
+        std::cerr << "⚠️ Background not found: " << path << "\n";
+        return;
+    }
+
+    // Each screen gets the background at its own size, in its renderer's preferred format
+    BackgroundCache disk;
+    uint64_t sourceHash = 0;
+    bool prescale = DisplayConfig::PRESCALE_BACKGROUND && BackgroundCache::hashFile(path, sourceHash);
+    for (size_t i = 0; i < backgrounds.size(); i++) {
+        Background& bg = backgrounds[i];
+        bg.key.sourceHash = sourceHash;
+        bg.key.format = SDL_PIXELFORMAT_ARGB8888;
+        SDL_RendererInfo info;
+        if (renderers[i] && SDL_GetRendererInfo(renderers[i], &info) == 0 && info.num_texture_formats > 0)
+            bg.key.format = info.texture_formats[0];
+        if (!renderers[i] || SDL_GetRendererOutputSize(renderers[i], &bg.key.width, &bg.key.height) < 0 ||
+            bg.key.width <= 0 || bg.key.height <= 0)
+            prescale = false;
+    }
+
+    // Warm start: hand the mapped pixels to SDL without decoding anything
+    std::vector<size_t> misses;
+    for (size_t i = 0; i < backgrounds.size(); i++) {
+        Background& bg = backgrounds[i];
+        if (prescale && (bg.mapped = disk.open(bg.key))) {
+            bg.surface = SDL_CreateRGBSurfaceWithFormatFrom(bg.mapped.pixels(), bg.key.width, bg.key.height,
+                SDL_BITSPERPIXEL(bg.key.format), static_cast<int>(bg.mapped.pitch), bg.key.format);
+        }
+        if (bg.surface) {
+            std::cout << "🗃️ Background " << bg.key.width << "x" << bg.key.height << " mapped from "
+                      << disk.pathFor(bg.key) << "\n";
+        } else {
+            bg.mapped = MappedImage{};
+            misses.push_back(i);
+        }
+    }
+
+    // Cold start: decode the source once for every screen that missed
+    if (!misses.empty()) {
+        auto start = std::chrono::steady_clock::now();
+        SDL_Surface* decoded = IMG_Load(path.c_str());
+        if (!decoded) {
+            std::cerr << "⚠️ Could not decode background: " << path << " | " << IMG_GetError() << "\n";
+        } else if (!prescale) {
+            for (size_t i : misses) {
+                backgrounds[i].surface = SDL_ConvertSurfaceFormat(decoded, backgrounds[i].key.format, 0);
+                if (!backgrounds[i].surface)
+                    std::cerr << "⚠️ Could not convert background: " << SDL_GetError() << "\n";
+            }
+            SDL_FreeSurface(decoded);
+        } else {
+            SDL_Surface* rgba = SDL_ConvertSurfaceFormat(decoded, SDL_PIXELFORMAT_RGBA32, 0);
+            SDL_FreeSurface(decoded);
+
+            // Screens sharing a size and format share one resample; distinct ones run concurrently
+            std::vector<size_t> unique;
+            for (size_t i : misses) {
+                auto same = [&](size_t j) { return sameTarget(backgrounds[i].key, backgrounds[j].key); };
+                if (std::none_of(unique.begin(), unique.end(), same)) unique.push_back(i);
+            }
+            if (rgba) {
+                std::vector<std::thread> workers;
+                for (size_t i : unique) {
+                    workers.emplace_back([&, i]() {
+                        Background& bg = backgrounds[i];
+                        bg.surface = scaleFor(rgba, bg.key.format, bg.key.width, bg.key.height);
+                        if (bg.surface) disk.store(bg.key, bg.surface->pixels, static_cast<size_t>(bg.surface->pitch));
+                    });
+                }
+                for (std::thread& worker : workers) worker.join();
+
+                std::cout << "🖼️ Background resampled " << rgba->w << "x" << rgba->h << " for "
+                          << unique.size() << " resolution(s) (" << ImageScaler::name(ImageScaler::best()) << ") in "
+                          << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+                          << " ms\n";
+                SDL_FreeSurface(rgba);
+            }
+            // Duplicates copy their twin's pixels
+            for (size_t i : misses) {
+                if (backgrounds[i].surface) continue;
+                for (size_t j : unique) {
+                    if (backgrounds[j].surface && sameTarget(backgrounds[i].key, backgrounds[j].key)) {
+                        backgrounds[i].surface = SDL_ConvertSurfaceFormat(backgrounds[j].surface, backgrounds[i].key.format, 0);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // Textures belong to their renderer's thread: upload here, on the caller's
+    for (Background& bg : backgrounds) {
+        size_t index = &bg - backgrounds.data();
+        if (!bg.surface || !renderers[index]) continue;
+        bg.texture = SDL_CreateTextureFromSurface(renderers[index], bg.surface);
+        if (bg.texture) {
+            SDL_SetTextureBlendMode(bg.texture, SDL_BLENDMODE_BLEND);
+        } else {
+            std::cerr << "⚠️ Failed to create texture from image: " << SDL_GetError() << "\n";
+        }
+    }
+}
+
+void AssetCache::loadAlert(const std::string& path) {
+    if (!fs::exists(path)) {
+        std::cerr << "⚠️ Sound file missing: " << path << "\n";
+        return;
+    }
+
+    // Mix_LoadWAV resamples to the opened device format, so the mixer must be open
+    int frequency = 0;
+    Uint16 format = 0;
+    int channels = 0;
+    if (!Mix_QuerySpec(&frequency, &format, &channels)) {
+        std::cerr << "⚠️ Audio device not open, alert sound not cached.\n";
+        return;
+    }
+
+    // Warm start: the mixer reads the mapped samples in place (it never writes to a chunk)
+    AlertCache disk;
+    AlertCache::Key key{0, frequency, format, channels, LoudnessTarget{}};
+    bool persist = AudioConfig::NORMALIZE_LOUDNESS && format == AUDIO_S16SYS && channels > 0 &&
+                   BackgroundCache::hashFile(path, key.sourceHash);
+    if (persist && (mappedAlert = disk.open(key))) {
+        chunk = Mix_QuickLoad_RAW(static_cast<Uint8*>(mappedAlert.samples()),
+                                  static_cast<Uint32>(mappedAlert.sampleBytes()));
+        if (chunk) {
+            loudness = mappedAlert.loudness;
+            normalized = true;
+            std::cout << "🗃️ Alert sound mapped from " << disk.pathFor(key) << "\n";
+            return;
+        }
+        mappedAlert = MappedSound{};
+    }
+
+    chunk = Mix_LoadWAV(path.c_str());
+    if (!chunk) {
+        std::cerr << "⚠️ Could not load sound: " << path << " | " << Mix_GetError() << "\n";
+        return;
+    }
+    if (!AudioConfig::NORMALIZE_LOUDNESS) return;
+
+    // Normalized once here, so alerts play at the same loudness without changing the system volume
+    if (format != AUDIO_S16SYS || channels <= 0) {
+        std::cerr << "⚠️ Mixer format not 16-bit, alert loudness left as is.\n";
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    size_t frames = chunk->alen / (sizeof(int16_t) * static_cast<size_t>(channels));
+    loudness = LoudnessNormalizer::normalize(reinterpret_cast<int16_t*>(chunk->abuf), frames, channels, frequency,
+                                             key.target);
+    normalized = true;
+    if (persist) disk.store(key, chunk->abuf, chunk->alen, loudness);
+    std::cout << "🔊 Alert loudness " << loudness.source.loudnessLufs << " LUFS, peak "
+              << loudness.source.peakDbfs << " dBFS → gain " << loudness.gainDb << " dB ("
+              << LoudnessNormalizer::name(loudness.kernel) << ") in "
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+              << " ms\n";
+}
+
+void AssetCache::release() {
+    releaseImages();
+    releaseSound();
+}
+
+void AssetCache::releaseImages() {
+    // Surfaces may point into their mapping, so they go first
+    for (Background& bg : backgrounds) {
+        if (bg.texture) SDL_DestroyTexture(bg.texture);
+        if (bg.surface) SDL_FreeSurface(bg.surface);
+    }
+    backgrounds.clear();
+}
+
+void AssetCache::releaseSound() {
+    // A mapped chunk points into its mapping, so it goes first
+    if (chunk) Mix_FreeChunk(chunk);
+    chunk = nullptr;
+    mappedAlert = MappedSound{};
+    normalized = false;
+}
+
+AssetFootprint AssetCache::footprint() const {
+    AssetFootprint fp;
+    for (const Background& bg : backgrounds) {
+        if (bg.surface) fp.surfaceBytes += static_cast<size_t>(bg.surface->pitch) * bg.surface->h;
+        if (bg.texture) {
+            Uint32 format = 0;
+            int w = 0, h = 0;
+            SDL_QueryTexture(bg.texture, &format, nullptr, &w, &h);
+            fp.textureBytes += static_cast<size_t>(w) * h * SDL_BYTESPERPIXEL(format);
+        }
+    }
+    if (chunk) fp.pcmBytes = chunk->alen;
+    return fp;
+}
@@ -0,0 +1,52 @@
+#include "../include/ConfigStore.hpp"
+#include <algorithm>
+#include <cstdint>
+
+ConfigStore::ConfigStore(std::unique_ptr<RuntimeConfig> initial) {
+    if (!initial) initial = std::make_unique<RuntimeConfig>();
+    initial->version = ++version;
+    current.store(initial.release(), std::memory_order_release);
+}
+
+ConfigStore::~ConfigStore() {
+    for (const Retired& old : retired) delete old.config;
+    delete current.load(std::memory_order_acquire);
+}
+
+ConfigStore::Snapshot ConfigStore::read(size_t reader) const {
+    std::atomic<uint64_t>& slot = readers[reader];
+
+    // Announce the epoch before loading the pointer: the writer either sees
+    // this slot busy, or we see the pointer it published (both seq_cst).
+    slot.store(epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    return Snapshot(&slot, current.load(std::memory_order_seq_cst));
+}
+
+uint64_t ConfigStore::publish(std::unique_ptr<RuntimeConfig> next) {
+    next->version = ++version;
+    const RuntimeConfig* old = current.exchange(next.release(), std::memory_order_seq_cst);
+
+    // Readers announcing this epoch or later can only load the new snapshot
+    uint64_t retiredAt = epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+    retired.push_back(Retired{old, retiredAt});
+    reclaim();
+    return version;
+}
+
+void ConfigStore::reclaim() {
+    if (retired.empty()) return;
+
+    // Oldest epoch any active reader may have observed
+    uint64_t oldestActive = UINT64_MAX;
+    for (const std::atomic<uint64_t>& slot : readers) {
+        uint64_t seen = slot.load(std::memory_order_seq_cst);
+        if (seen != 0) oldestActive = std::min(oldestActive, seen);
+    }
+
+    size_t kept = 0;
+    for (const Retired& old : retired) {
+        if (old.epoch <= oldestActive) delete old.config;
+        else retired[kept++] = old;
+    }
+    retired.resize(kept);
+}
@@ -0,0 +1,63 @@
+#include "../include/ConfigWatcher.hpp"
+#include <sys/inotify.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+ConfigWatcher::~ConfigWatcher() {
+    if (fd >= 0) close(fd);
+}
+
+bool ConfigWatcher::start(EventLoop& loop, const std::string& dir, std::vector<std::string> files,
+                          std::chrono::milliseconds debounce, Callback onChange) {
+    names = std::move(files);
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "⚠️ inotify unavailable, config changes need a restart: " << strerror(errno) << "\n";
+        return false;
+    }
+
+    // Catch in-place writes, atomic renames and deletions alike
+    uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MOVED_FROM;
+    if (inotify_add_watch(fd, dir.c_str(), mask) < 0) {
+        std::cerr << "⚠️ Cannot watch " << dir << ": " << strerror(errno) << "\n";
+        close(fd);
+        fd = -1;
+        return false;
+    }
+
+    debounceTimer = loop.addTimer(std::move(onChange));
+    loop.watch(fd, EPOLLIN, [this, &loop, debounce](uint32_t) {
+        // Restarting the timer on every event waits for the save to settle
+        if (drain()) loop.armTimer(debounceTimer, debounce);
+    });
+
+    std::cout << "👁️ Watching " << dir << " for configuration changes\n";
+    return true;
+}
+
+bool ConfigWatcher::drain() {
+    alignas(inotify_event) char buffer[4096];
+    bool relevant = false;
+
+    while (true) {
+        ssize_t len = read(fd, buffer, sizeof(buffer));
+        if (len <= 0) break;
+
+        for (ssize_t offset = 0; offset < len;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len > 0 && std::find(names.begin(), names.end(), event->name) != names.end())
+                relevant = true;
+            offset += sizeof(inotify_event) + event->len;
+        }
+    }
+    return relevant;
+}
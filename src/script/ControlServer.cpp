@@ -0,0 +1,113 @@
+#include "../include/ControlServer.hpp"
+#include "../include/Config.hpp"
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+ControlServer::~ControlServer() {
+    for (int fd : clients) close(fd);
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+}
+
+bool ControlServer::start(EventLoop& eventLoop, const std::string& path, Handler handler) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "⚠️ Control socket path too long: " << path << "\n";
+        return false;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        std::cerr << "⚠️ Control socket unavailable: " << strerror(errno) << "\n";
+        return false;
+    }
+
+    // A previous instance that crashed leaves its socket file behind; a live one answers and keeps it.
+    // The probe never waits: a wedged instance with a full backlog answers EAGAIN and still counts as live
+    int probe = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int probed = probe < 0 ? -1 : connect(probe, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    int probeError = errno;
+    if (probe >= 0) close(probe);
+    if (probe >= 0 && (probed == 0 || probeError == EAGAIN || probeError == EINPROGRESS)) {
+        std::cerr << "⚠️ Control socket " << path << " is served by another instance, not taking it over\n";
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    if (probe >= 0 && (probeError == ECONNREFUSED || probeError == ENOENT)) unlink(path.c_str());
+    // umask() would apply to every thread already running, so the mode is set on the path instead;
+    // $XDG_RUNTIME_DIR is 0700, nobody else can reach the socket in between
+    bool bound = bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    if (!bound || chmod(path.c_str(), 0600) < 0 || listen(listenFd, ControlConfig::MAX_CLIENTS) < 0) {
+        std::cerr << "⚠️ Cannot listen on " << path << ": " << strerror(errno) << "\n";
+        if (bound) unlink(path.c_str());
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    loop = &eventLoop;
+    socketPath = path;
+    onRequest = std::move(handler);
+    loop->watch(listenFd, EPOLLIN, [this](uint32_t) { acceptClients(); });
+
+    std::cout << "🎛️ Control socket listening on " << path << "\n";
+    return true;
+}
+
+void ControlServer::acceptClients() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            return; // EAGAIN: no more pending connections
+        }
+        if (clients.size() >= static_cast<size_t>(ControlConfig::MAX_CLIENTS)) {
+            close(fd);
+            continue;
+        }
+        clients.push_back(fd);
+        loop->watch(fd, EPOLLIN, [this, fd](uint32_t events) { serve(fd, events); });
+    }
+}
+
+void ControlServer::serve(int fd, uint32_t events) {
+    // One request per wakeup: the loop is level-triggered, so busy clients take turns
+    char request[ControlConfig::MAX_REQUEST_BYTES + 1];
+    ssize_t len = recv(fd, request, sizeof(request), MSG_DONTWAIT);
+    if (len < 0 && (errno == EAGAIN || errno == EINTR) && !(events & (EPOLLHUP | EPOLLERR))) return;
+    if (len <= 0) {
+        drop(fd);
+        return;
+    }
+
+    reply.clear();
+    if (static_cast<size_t>(len) > ControlConfig::MAX_REQUEST_BYTES) {
+        reply = "error request too long";
+    } else {
+        std::string_view text(request, static_cast<size_t>(len));
+        while (!text.empty() && (text.back() == '\n' || text.back() == '\r' || text.back() == ' '))
+            text.remove_suffix(1);
+        onRequest(text, reply);
+    }
+
+    // A client that does not read its replies is not worth waiting for
+    if (send(fd, reply.data(), reply.size(), MSG_DONTWAIT | MSG_NOSIGNAL) < 0) drop(fd);
+}
+
+void ControlServer::drop(int fd) {
+    loop->unwatch(fd);
+    close(fd);
+    clients.erase(std::remove(clients.begin(), clients.end(), fd), clients.end());
+}
@@ -0,0 +1,132 @@
+#include "../include/DeviceIndex.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char MAGIC[8] = {'U', 'S', 'B', 'M', 'S', 'N', '0', '1'};
+
+    /// Snapshot header; entries follow.
+    struct FileHeader {
+        char magic[8];
+        char bootId[40];
+        uint32_t count;
+        uint8_t reserved[12];
+    };
+    static_assert(sizeof(FileHeader) == 64, "snapshot header must stay 64 bytes");
+
+    /// On-disk entry.
+    struct FileEntry {
+        uint64_t identity;
+        uint32_t instance;
+        uint32_t reserved;
+    };
+    static_assert(sizeof(FileEntry) == 16, "snapshot entry must stay 16 bytes");
+
+    /// Upper bound on entries accepted from disk (a corrupt count cannot exhaust memory).
+    constexpr uint32_t MAX_ENTRIES = 1 << 16;
+}
+
+DeviceIndex::Entry DeviceIndex::keyOf(const UsbEvent& event) {
+    // FNV-1a over the port path, then the IDs folded in
+    uint64_t hash = event.devpathHash();
+    hash = (hash ^ (static_cast<uint64_t>(event.vendor) << 16 | event.product)) * 0x100000001b3ull;
+
+    Entry entry;
+    entry.identity = hash;
+    entry.instance = static_cast<uint32_t>(event.busnum) << 16 | event.devnum;
+    return entry;
+}
+
+void DeviceIndex::insert(const UsbEvent& event) {
+    Entry entry = keyOf(event);
+    auto it = std::lower_bound(entries.begin(), entries.end(), entry);
+    if (it == entries.end() || !(*it == entry)) entries.insert(it, entry);
+}
+
+void DeviceIndex::erase(const UsbEvent& event) {
+    Entry entry = keyOf(event);
+    auto it = std::lower_bound(entries.begin(), entries.end(), entry);
+    if (it != entries.end() && *it == entry) entries.erase(it);
+}
+
+bool DeviceIndex::contains(const UsbEvent& event, bool sameBoot) const {
+    Entry entry = keyOf(event);
+    if (sameBoot) return std::binary_search(entries.begin(), entries.end(), entry);
+
+    auto it = std::lower_bound(entries.begin(), entries.end(), Entry{entry.identity, 0});
+    return it != entries.end() && it->identity == entry.identity;
+}
+
+std::string DeviceIndex::bootId() {
+    std::string id;
+    std::ifstream("/proc/sys/kernel/random/boot_id") >> id;
+    return id;
+}
+
+bool DeviceIndex::load(const std::string& path, bool& sameBoot) {
+    entries.clear();
+    sameBoot = false;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.count > MAX_ENTRIES) {
+        std::cerr << "⚠️ Ignoring invalid device snapshot: " << path << "\n";
+        return false;
+    }
+
+    std::vector<FileEntry> raw(header.count);
+    if (!file.read(reinterpret_cast<char*>(raw.data()), static_cast<std::streamsize>(raw.size() * sizeof(FileEntry)))) {
+        std::cerr << "⚠️ Ignoring truncated device snapshot: " << path << "\n";
+        return false;
+    }
+    entries.reserve(raw.size());
+    for (const FileEntry& e : raw) entries.push_back(Entry{e.identity, e.instance});
+    std::sort(entries.begin(), entries.end());
+
+    header.bootId[sizeof(header.bootId) - 1] = '\0';
+    std::string current = bootId();
+    sameBoot = !current.empty() && current == header.bootId;
+    return true;
+}
+
+bool DeviceIndex::save(const std::string& path) const {
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    std::string boot = bootId();
+    std::strncpy(header.bootId, boot.c_str(), sizeof(header.bootId) - 1);
+    header.count = static_cast<uint32_t>(std::min<size_t>(entries.size(), MAX_ENTRIES));
+
+    std::vector<FileEntry> raw;
+    raw.reserve(header.count);
+    for (size_t i = 0; i < header.count; i++) raw.push_back(FileEntry{entries[i].identity, entries[i].instance, 0});
+
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(raw.data()), static_cast<std::streamsize>(raw.size() * sizeof(FileEntry)));
+        if (!file.flush()) {
+            std::cerr << "⚠️ Could not write device snapshot: " << temp << "\n";
+            return false;
+        }
+    }
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::cerr << "⚠️ Could not store device snapshot: " << strerror(errno) << "\n";
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
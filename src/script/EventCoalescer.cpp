@@ -0,0 +1,54 @@
+#include "../include/EventCoalescer.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+
+size_t UsbEventBatch::format(char* buf, size_t size) const {
+    if (size == 0) return 0;
+    if (events.size() == 1) return events.front().format(buf, size);
+
+    int len = snprintf(buf, size, "%zu devices:", events.size());
+    size_t used = len < 0 ? 0 : std::min<size_t>(len, size - 1);
+    for (const UsbEvent& event : events) {
+        int line = snprintf(buf + used, size - used, "\n%04x:%04x %s", event.vendor, event.product,
+                            event.devnode[0] ? event.devnode : "unknown");
+        // Drop a line that did not fit rather than show half of it
+        if (line < 0 || used + static_cast<size_t>(line) >= size) break;
+        used += static_cast<size_t>(line);
+    }
+    buf[used] = '\0';
+    return used;
+}
+
+EventCoalescer::EventCoalescer(std::chrono::milliseconds window, size_t maxBatch)
+    : window(window), maxBatch(std::max<size_t>(maxBatch, 1)) {
+    batch.events.reserve(this->maxBatch);
+    ready.events.reserve(this->maxBatch);
+}
+
+void EventCoalescer::add(const UsbEvent& event) {
+    if (batch.events.empty()) batch.firstReceivedAt = event.receivedAt;
+    batch.events.push_back(event);
+
+    // Per-device detail always goes to the log, even when the alert is merged
+    char id[UsbEvent::ID_TEXT_SIZE];
+    event.formatId(id);
+    std::cout << "🔌 " << UsbEvent::actionName(event.action) << " " << id << " "
+              << (event.devnode[0] ? event.devnode : "unknown") << " (batch " << batch.events.size() << ")\n";
+}
+
+std::chrono::steady_clock::time_point EventCoalescer::deadline() const {
+    return batch.firstReceivedAt + window;
+}
+
+bool EventCoalescer::due(std::chrono::steady_clock::time_point now) const {
+    if (batch.events.empty()) return false;
+    return batch.events.size() >= maxBatch || now >= deadline();
+}
+
+const UsbEventBatch& EventCoalescer::take() {
+    // Swap buffers so both keep their reserved capacity
+    std::swap(ready, batch);
+    batch.events.clear();
+    return ready;
+}
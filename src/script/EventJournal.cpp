@@ -0,0 +1,145 @@
+#include "../include/EventJournal.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char MAGIC[8] = {'U', 'S', 'B', 'M', 'J', 'R', '0', '1'};
+
+    size_t fileSize(uint32_t capacity) {
+        return EventJournal::HEADER_SIZE + static_cast<size_t>(capacity) * sizeof(JournalRecord);
+    }
+
+    bool validHeader(const JournalHeader& header, size_t size) {
+        return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+               header.recordSize == sizeof(JournalRecord) && header.capacity > 0 &&
+               size >= fileSize(header.capacity);
+    }
+}
+
+EventJournal::~EventJournal() {
+    if (!header) return;
+    msync(header, mappedSize, MS_ASYNC);
+    munmap(header, mappedSize);
+}
+
+bool EventJournal::open(const std::string& path, uint32_t capacity) {
+    if (header || capacity == 0) return false;
+
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        std::cerr << "⚠️ Could not open event journal " << path << ": " << strerror(errno) << "\n";
+        return false;
+    }
+
+    // An existing journal of the same layout is resumed; anything else starts over
+    struct stat st{};
+    fstat(fd, &st);
+    size_t size = fileSize(capacity);
+    bool resume = false;
+    if (static_cast<size_t>(st.st_size) == size) {
+        JournalHeader existing;
+        resume = pread(fd, &existing, sizeof(existing), 0) == static_cast<ssize_t>(sizeof(existing)) &&
+                 validHeader(existing, size) && existing.capacity == capacity;
+    }
+    if (!resume) {
+        if (st.st_size > 0) std::cout << "🧾 Event journal layout changed, starting a new one\n";
+        if (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            std::cerr << "⚠️ Could not size event journal: " << strerror(errno) << "\n";
+            ::close(fd);
+            return false;
+        }
+    }
+
+    void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        std::cerr << "⚠️ Could not map event journal: " << strerror(errno) << "\n";
+        return false;
+    }
+
+    header = static_cast<JournalHeader*>(map);
+    records = reinterpret_cast<JournalRecord*>(static_cast<char*>(map) + HEADER_SIZE);
+    mappedSize = size;
+    if (!resume) {
+        // The file is zero-filled: only the identification is left to write
+        std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+        header->recordSize = sizeof(JournalRecord);
+        header->capacity = capacity;
+        header->written.store(0, std::memory_order_release);
+    }
+    std::cout << "🧾 Journaling USB events to " << path << " ("
+              << header->written.load(std::memory_order_relaxed) << " so far)\n";
+    return true;
+}
+
+void EventJournal::append(const UsbEvent& event, uint8_t flags) {
+    if (!header) return;
+
+    // clock_gettime is served by the vDSO: no syscall
+    timespec now{};
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    uint64_t position = header->written.load(std::memory_order_relaxed);
+    JournalRecord& slot = records[position % header->capacity];
+
+    // Seqlock-style: invalidate the slot, fill it, then publish its sequence
+    __atomic_store_n(&slot.sequence, 0u, __ATOMIC_RELAXED);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timeNs = static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+    slot.devpathHash = event.devpathHash();
+    slot.vendor = event.vendor;
+    slot.product = event.product;
+    slot.busnum = event.busnum;
+    slot.devnum = event.devnum;
+    slot.action = static_cast<uint8_t>(event.action);
+    slot.flags = flags;
+    slot.reserved = 0;
+    __atomic_store_n(&slot.sequence, static_cast<uint32_t>(position + 1), __ATOMIC_RELEASE);
+
+    header->written.store(position + 1, std::memory_order_release);
+}
+
+void EventJournal::sync() {
+    if (header) msync(header, mappedSize, MS_ASYNC);
+}
+
+JournalView::~JournalView() {
+    if (header) munmap(const_cast<JournalHeader*>(header), mappedSize);
+}
+
+bool JournalView::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < EventJournal::HEADER_SIZE) {
+        ::close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) return false;
+
+    const auto* mapped = static_cast<const JournalHeader*>(map);
+    if (!validHeader(*mapped, size)) {
+        munmap(map, size);
+        return false;
+    }
+    header = mapped;
+    records = reinterpret_cast<const JournalRecord*>(static_cast<const char*>(map) + EventJournal::HEADER_SIZE);
+    mappedSize = size;
+    return true;
+}
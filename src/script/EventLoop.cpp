@@ -0,0 +1,174 @@
+#include "../include/EventLoop.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <sys/signalfd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // Events handled per epoll_wait() call.
+    constexpr int MAX_EVENTS = 32;
+
+    timespec toTimespec(std::chrono::nanoseconds ns) {
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(ns.count() / 1000000000);
+        ts.tv_nsec = static_cast<long>(ns.count() % 1000000000);
+        return ts;
+    }
+}
+
+EventLoop::EventLoop() {
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epollFd < 0 || stopFd < 0) {
+        std::cerr << "❌ Event loop creation failed: " << strerror(errno) << "\n";
+        return;
+    }
+
+    // The stop descriptor only has to interrupt epoll_wait(); run() checks the flag
+    watch(stopFd, EPOLLIN, [this](uint32_t) {
+        uint64_t value;
+        while (read(stopFd, &value, sizeof(value)) > 0) {}
+    });
+}
+
+EventLoop::~EventLoop() {
+    for (int fd : ownedFds) close(fd);
+    if (stopFd >= 0) close(stopFd);
+    if (epollFd >= 0) close(epollFd);
+}
+
+bool EventLoop::watch(int fd, uint32_t events, Handler handler) {
+    if (fd < 0 || epollFd < 0) return false;
+
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        std::cerr << "❌ epoll_ctl(ADD, " << fd << ") failed: " << strerror(errno) << "\n";
+        return false;
+    }
+
+    if (static_cast<size_t>(fd) >= handlers.size()) handlers.resize(fd + 1);
+    handlers[fd] = std::make_unique<Handler>(std::move(handler));
+    return true;
+}
+
+void EventLoop::unwatch(int fd) {
+    if (fd < 0 || static_cast<size_t>(fd) >= handlers.size() || !handlers[fd]) return;
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    // The handler may be the one currently running: destroy it after dispatch
+    retired.push_back(std::move(handlers[fd]));
+}
+
+int EventLoop::addTimer(TimerHandler handler) {
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "❌ timerfd creation failed: " << strerror(errno) << "\n";
+        return -1;
+    }
+
+    bool ok = watch(fd, EPOLLIN, [fd, handler = std::move(handler)](uint32_t) {
+        uint64_t expirations = 0;
+        if (read(fd, &expirations, sizeof(expirations)) == sizeof(expirations)) handler();
+    });
+    if (!ok) {
+        close(fd);
+        return -1;
+    }
+    ownedFds.push_back(fd);
+    return fd;
+}
+
+void EventLoop::armTimer(int timer, std::chrono::nanoseconds delay, std::chrono::nanoseconds interval) {
+    // A zero it_value would disarm the timer: expire as soon as possible instead
+    itimerspec spec{};
+    spec.it_value = toTimespec(std::max(delay, std::chrono::nanoseconds(1)));
+    spec.it_interval = toTimespec(interval);
+    timerfd_settime(timer, 0, &spec, nullptr);
+}
+
+void EventLoop::disarmTimer(int timer) {
+    itimerspec spec{};
+    timerfd_settime(timer, 0, &spec, nullptr);
+}
+
+void EventLoop::removeTimer(int timer) {
+    unwatch(timer);
+    closeOwned(timer);
+}
+
+bool EventLoop::watchSignals(std::initializer_list<int> signals, SignalHandler handler) {
+    sigset_t mask;
+    sigemptyset(&mask);
+    for (int signo : signals) sigaddset(&mask, signo);
+
+    // Block normal delivery so the signals are only seen through the signalfd
+    if (pthread_sigmask(SIG_BLOCK, &mask, nullptr) != 0) {
+        std::cerr << "❌ Could not block signals\n";
+        return false;
+    }
+
+    int fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "❌ signalfd creation failed: " << strerror(errno) << "\n";
+        return false;
+    }
+
+    bool ok = watch(fd, EPOLLIN, [fd, handler = std::move(handler)](uint32_t) {
+        signalfd_siginfo info;
+        while (read(fd, &info, sizeof(info)) == sizeof(info))
+            handler(static_cast<int>(info.ssi_signo));
+    });
+    if (!ok) {
+        close(fd);
+        return false;
+    }
+    ownedFds.push_back(fd);
+    return true;
+}
+
+void EventLoop::run() {
+    if (epollFd < 0) return;
+
+    epoll_event events[MAX_EVENTS];
+    while (!stopping.load(std::memory_order_acquire)) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        wakeupCount.fetch_add(1, std::memory_order_relaxed);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "❌ epoll_wait failed: " << strerror(errno) << "\n";
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            int fd = events[i].data.fd;
+            // Skip descriptors unwatched by an earlier handler of this round
+            if (static_cast<size_t>(fd) < handlers.size() && handlers[fd])
+                (*handlers[fd])(events[i].events);
+        }
+        retired.clear();
+    }
+}
+
+void EventLoop::stop() {
+    stopping.store(true, std::memory_order_release);
+    uint64_t one = 1;
+    if (write(stopFd, &one, sizeof(one)) < 0 && errno != EAGAIN) {
+        std::cerr << "⚠️ Could not wake event loop: " << strerror(errno) << "\n";
+    }
+}
+
+void EventLoop::closeOwned(int fd) {
+    auto it = std::find(ownedFds.begin(), ownedFds.end(), fd);
+    if (it == ownedFds.end()) return;
+    ownedFds.erase(it);
+    close(fd);
+}
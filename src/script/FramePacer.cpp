@@ -0,0 +1,33 @@
+#include "../include/FramePacer.hpp"
+#include <time.h>
+#include <cerrno>
+#include <algorithm>
+
+FramePacer::FramePacer(std::chrono::nanoseconds period)
+    : interval(std::max<std::chrono::nanoseconds>(period, std::chrono::milliseconds(1))) {}
+
+void FramePacer::start() {
+    deadline = std::chrono::steady_clock::now() + interval;
+    missedTotal = 0;
+}
+
+uint32_t FramePacer::wait() {
+    // Late frame: skip the deadlines already behind us instead of racing to catch up
+    auto now = std::chrono::steady_clock::now();
+    uint32_t skipped = 0;
+    if (now >= deadline) {
+        skipped = static_cast<uint32_t>((now - deadline) / interval) + 1;
+        deadline += interval * skipped;
+        missedTotal += skipped;
+    }
+
+    // steady_clock is CLOCK_MONOTONIC on Linux, so its epoch matches clock_nanosleep's
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch());
+    timespec until{};
+    until.tv_sec = static_cast<time_t>(sinceEpoch.count() / 1000000000);
+    until.tv_nsec = static_cast<long>(sinceEpoch.count() % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, nullptr) == EINTR) {}
+
+    deadline += interval;
+    return skipped;
+}
@@ -0,0 +1,57 @@
+#include "../include/IdleTracker.hpp"
+#include <unistd.h>
+#include <cstdio>
+
+void IdleTracker::start(uint64_t wakeups) {
+    current = State::Active;
+    since = std::chrono::steady_clock::now();
+    wakeupsSince = wakeups;
+    Usage& usage = totals[static_cast<int>(current)];
+    usage.periods++;
+    usage.rssBytes = residentBytes();
+}
+
+void IdleTracker::enter(State next, uint64_t wakeups) {
+    auto now = std::chrono::steady_clock::now();
+    Usage& closing = totals[static_cast<int>(current)];
+    closing.time += now - since;
+    closing.wakeups += wakeups - wakeupsSince;
+
+    current = next;
+    since = now;
+    wakeupsSince = wakeups;
+    Usage& opening = totals[static_cast<int>(current)];
+    opening.periods++;
+    opening.rssBytes = residentBytes();
+}
+
+void IdleTracker::report(std::ostream& out, uint64_t wakeups) const {
+    auto now = std::chrono::steady_clock::now();
+    for (State state : {State::Active, State::Idle}) {
+        Usage usage = totals[static_cast<int>(state)];
+        if (state == current) {
+            usage.time += now - since;
+            usage.wakeups += wakeups - wakeupsSince;
+        }
+        double seconds = std::chrono::duration<double>(usage.time).count();
+
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-6s  %3llu period(s)  %10.1f s  %8llu wakeups (%6.3f/s)  rss %7.1f MiB\n",
+                      state == State::Active ? "active" : "idle",
+                      static_cast<unsigned long long>(usage.periods), seconds,
+                      static_cast<unsigned long long>(usage.wakeups),
+                      seconds > 0 ? static_cast<double>(usage.wakeups) / seconds : 0.0,
+                      static_cast<double>(usage.rssBytes) / (1024.0 * 1024.0));
+        out << line;
+    }
+}
+
+size_t IdleTracker::residentBytes() {
+    // statm: size resident shared text lib data dt, in pages
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) return 0;
+    unsigned long size = 0, resident = 0;
+    int fields = std::fscanf(statm, "%lu %lu", &size, &resident);
+    std::fclose(statm);
+    return fields == 2 ? static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+}
@@ -0,0 +1,289 @@
+#include "../include/ImageScaler.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IMAGE_SCALER_X86 1
+#endif
+
+namespace {
+    // Weights are 14-bit fixed point: products of 8-bit samples stay well inside int32
+    constexpr int PRECISION = 14;
+    constexpr int32_t ONE = 1 << PRECISION;
+    constexpr int32_t HALF = 1 << (PRECISION - 1);
+
+    using Weights = const int16_t*;
+
+    inline uint8_t clampByte(int32_t value) {
+        return static_cast<uint8_t>(std::clamp(value >> PRECISION, 0, 255));
+    }
+
+    // Applies the output channel order to `count` pixels in place
+    void applyLayoutScalar(uint8_t* pixels, size_t count, ImageScaler::PixelLayout layout) {
+        if (!layout.swapRedBlue && !layout.opaque) return;
+        for (size_t i = 0; i < count; i++, pixels += 4) {
+            if (layout.swapRedBlue) std::swap(pixels[0], pixels[2]);
+            if (layout.opaque) pixels[3] = 255;
+        }
+    }
+
+    void horizontalScalar(const uint8_t* row, uint8_t* out, int start, int count, Weights w) {
+        const uint8_t* p = row + 4 * static_cast<size_t>(start);
+        int32_t acc[4] = {HALF, HALF, HALF, HALF};
+        for (int k = 0; k < count; k++) {
+            for (int c = 0; c < 4; c++) acc[c] += w[k] * p[4 * k + c];
+        }
+        for (int c = 0; c < 4; c++) out[c] = clampByte(acc[c]);
+    }
+
+    // One output row from `count` intermediate rows starting at `base`, over `bytes` bytes
+    void verticalScalar(const uint8_t* base, size_t stride, int count, Weights w,
+                        uint8_t* out, size_t bytes, ImageScaler::PixelLayout layout) {
+        for (size_t i = 0; i < bytes; i++) {
+            int32_t acc = HALF;
+            for (int k = 0; k < count; k++) acc += w[k] * base[k * stride + i];
+            out[i] = clampByte(acc);
+        }
+        applyLayoutScalar(out, bytes / 4, layout);
+    }
+
+#ifdef IMAGE_SCALER_X86
+    // Two weights per 32-bit lane, matching the (tap k, tap k+1) interleave of the samples
+    __attribute__((target("sse2")))
+    inline __m128i weightPair(int16_t w0, int16_t w1) {
+        return _mm_set1_epi32(static_cast<int32_t>(static_cast<uint16_t>(w1)) << 16 | static_cast<uint16_t>(w0));
+    }
+
+    __attribute__((target("sse2")))
+    void horizontalSSE2(const uint8_t* row, uint8_t* out, int start, int count, Weights w) {
+        const __m128i zero = _mm_setzero_si128();
+        const uint8_t* p = row + 4 * static_cast<size_t>(start);
+        __m128i acc = _mm_set1_epi32(HALF);
+
+        int k = 0;
+        for (; k + 1 < count; k += 2) {
+            // r0 g0 b0 a0 r1 g1 b1 a1 → (r0 r1)(g0 g1)(b0 b1)(a0 a1) as 16-bit pairs
+            __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + 4 * k)), zero);
+            __m128i pairs = _mm_unpacklo_epi16(pixels, _mm_srli_si128(pixels, 8));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(pairs, weightPair(w[k], w[k + 1])));
+        }
+        if (k < count) {
+            int32_t last;
+            std::copy(p + 4 * k, p + 4 * k + 4, reinterpret_cast<uint8_t*>(&last));
+            __m128i pixel = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(last), zero), zero);
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(pixel, weightPair(w[k], 0)));
+        }
+
+        acc = _mm_srai_epi32(acc, PRECISION);
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(acc, acc), zero);
+        int32_t result = _mm_cvtsi128_si32(packed);
+        std::copy(reinterpret_cast<uint8_t*>(&result), reinterpret_cast<uint8_t*>(&result) + 4, out);
+    }
+
+    // Swaps R/B and/or forces alpha on four packed 0xAABBGGRR pixels
+    __attribute__((target("sse2")))
+    inline __m128i applyLayoutSSE2(__m128i px, ImageScaler::PixelLayout layout) {
+        if (layout.swapRedBlue) {
+            const __m128i keep = _mm_set1_epi32(static_cast<int32_t>(0xFF00FF00u));
+            const __m128i low = _mm_set1_epi32(0xFF);
+            px = _mm_or_si128(_mm_and_si128(px, keep),
+                 _mm_or_si128(_mm_and_si128(_mm_srli_epi32(px, 16), low),
+                              _mm_slli_epi32(_mm_and_si128(px, low), 16)));
+        }
+        if (layout.opaque) px = _mm_or_si128(px, _mm_set1_epi32(static_cast<int32_t>(0xFF000000u)));
+        return px;
+    }
+
+    __attribute__((target("sse2")))
+    void verticalSSE2(const uint8_t* base, size_t stride, int count, Weights w,
+                      uint8_t* out, size_t bytes, ImageScaler::PixelLayout layout) {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= bytes; i += 16) {
+            __m128i acc0 = _mm_set1_epi32(HALF), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+            for (int k = 0; k < count; k += 2) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + k * stride + i));
+                __m128i b = k + 1 < count
+                    ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(base + (k + 1) * stride + i)) : zero;
+                __m128i weights = weightPair(w[k], k + 1 < count ? w[k + 1] : 0);
+
+                // Interleave the two rows byte by byte, widen, and multiply-add the pairs
+                __m128i lo = _mm_unpacklo_epi8(a, b);
+                __m128i hi = _mm_unpackhi_epi8(a, b);
+                acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), weights));
+                acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), weights));
+                acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), weights));
+                acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), weights));
+            }
+            __m128i first = _mm_packs_epi32(_mm_srai_epi32(acc0, PRECISION), _mm_srai_epi32(acc1, PRECISION));
+            __m128i second = _mm_packs_epi32(_mm_srai_epi32(acc2, PRECISION), _mm_srai_epi32(acc3, PRECISION));
+            __m128i pixels = applyLayoutSSE2(_mm_packus_epi16(first, second), layout);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), pixels);
+        }
+        verticalScalar(base + i, stride, count, w, out + i, bytes - i, layout);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i applyLayoutAVX2(__m256i px, ImageScaler::PixelLayout layout) {
+        if (layout.swapRedBlue) {
+            const __m256i keep = _mm256_set1_epi32(static_cast<int32_t>(0xFF00FF00u));
+            const __m256i low = _mm256_set1_epi32(0xFF);
+            px = _mm256_or_si256(_mm256_and_si256(px, keep),
+                 _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(px, 16), low),
+                                 _mm256_slli_epi32(_mm256_and_si256(px, low), 16)));
+        }
+        if (layout.opaque) px = _mm256_or_si256(px, _mm256_set1_epi32(static_cast<int32_t>(0xFF000000u)));
+        return px;
+    }
+
+    // Same as verticalSSE2 on 32 bytes; unpack and pack are both per 128-bit lane, so byte order is preserved
+    __attribute__((target("avx2")))
+    void verticalAVX2(const uint8_t* base, size_t stride, int count, Weights w,
+                      uint8_t* out, size_t bytes, ImageScaler::PixelLayout layout) {
+        const __m256i zero = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 32 <= bytes; i += 32) {
+            __m256i acc0 = _mm256_set1_epi32(HALF), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+            for (int k = 0; k < count; k += 2) {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + k * stride + i));
+                __m256i b = k + 1 < count
+                    ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + (k + 1) * stride + i)) : zero;
+                int16_t w1 = k + 1 < count ? w[k + 1] : 0;
+                __m256i weights = _mm256_set1_epi32(
+                    static_cast<int32_t>(static_cast<uint16_t>(w1)) << 16 | static_cast<uint16_t>(w[k]));
+
+                __m256i lo = _mm256_unpacklo_epi8(a, b);
+                __m256i hi = _mm256_unpackhi_epi8(a, b);
+                acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_unpacklo_epi8(lo, zero), weights));
+                acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_unpackhi_epi8(lo, zero), weights));
+                acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_unpacklo_epi8(hi, zero), weights));
+                acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_unpackhi_epi8(hi, zero), weights));
+            }
+            __m256i first = _mm256_packs_epi32(_mm256_srai_epi32(acc0, PRECISION), _mm256_srai_epi32(acc1, PRECISION));
+            __m256i second = _mm256_packs_epi32(_mm256_srai_epi32(acc2, PRECISION), _mm256_srai_epi32(acc3, PRECISION));
+            __m256i pixels = applyLayoutAVX2(_mm256_packus_epi16(first, second), layout);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), pixels);
+        }
+        verticalSSE2(base + i, stride, count, w, out + i, bytes - i, layout);
+    }
+#endif
+}
+
+ImageScaler::ImageScaler(int srcWidth, int srcHeight, int dstWidth, int dstHeight)
+    : srcW(srcWidth), srcH(srcHeight), dstW(dstWidth), dstH(dstHeight),
+      horizontal(buildAxis(srcWidth, dstWidth)), vertical(buildAxis(srcHeight, dstHeight)) {}
+
+ImageScaler::Axis ImageScaler::buildAxis(int srcSize, int dstSize) {
+    Axis axis;
+    if (srcSize <= 0 || dstSize <= 0) return axis;
+
+    // Enlarging: plain linear interpolation. Shrinking: the tent widens to cover every source pixel.
+    double ratio = static_cast<double>(srcSize) / dstSize;
+    double support = std::max(ratio, 1.0);
+
+    std::vector<double> raw;
+    axis.taps.resize(dstSize);
+    for (int out = 0; out < dstSize; out++) {
+        double center = (out + 0.5) * ratio;
+        int first = std::max(0, static_cast<int>(std::floor(center - support)));
+        int last = std::min(srcSize - 1, static_cast<int>(std::ceil(center + support)));
+
+        raw.clear();
+        double total = 0.0;
+        for (int in = first; in <= last; in++) {
+            double weight = std::max(0.0, 1.0 - std::fabs((in + 0.5 - center) / support));
+            raw.push_back(weight);
+            total += weight;
+        }
+
+        // Drop zero-weight edges, then quantize so the weights sum to exactly ONE
+        size_t begin = 0, end = raw.size();
+        while (begin < end && raw[begin] == 0.0) begin++;
+        while (end > begin && raw[end - 1] == 0.0) end--;
+        if (begin == end) {
+            // Degenerate (cannot happen with a positive support): copy the nearest sample
+            raw.assign(1, 1.0);
+            total = 1.0;
+            first = std::clamp(static_cast<int>(center), 0, srcSize - 1);
+            begin = 0;
+            end = 1;
+        }
+
+        Taps& taps = axis.taps[out];
+        taps.start = first + static_cast<int>(begin);
+        taps.count = static_cast<int>(end - begin);
+        taps.weights = axis.weights.size();
+
+        int32_t sum = 0;
+        size_t largest = begin;
+        for (size_t i = begin; i < end; i++) {
+            int16_t weight = static_cast<int16_t>(std::lround(raw[i] / total * ONE));
+            axis.weights.push_back(weight);
+            sum += weight;
+            if (raw[i] > raw[largest]) largest = i;
+        }
+        axis.weights[taps.weights + (largest - begin)] += static_cast<int16_t>(ONE - sum);
+    }
+    return axis;
+}
+
+bool ImageScaler::supported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar: return true;
+#ifdef IMAGE_SCALER_X86
+        case Kernel::SSE2: return __builtin_cpu_supports("sse2");
+        case Kernel::AVX2: return __builtin_cpu_supports("avx2");
+#endif
+        default: return false;
+    }
+}
+
+ImageScaler::Kernel ImageScaler::best() {
+    if (supported(Kernel::AVX2)) return Kernel::AVX2;
+    if (supported(Kernel::SSE2)) return Kernel::SSE2;
+    return Kernel::Scalar;
+}
+
+const char* ImageScaler::name(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::SSE2: return "SSE2";
+        case Kernel::AVX2: return "AVX2";
+        default: return "scalar";
+    }
+}
+
+void ImageScaler::scale(const uint8_t* src, size_t srcPitch, uint8_t* dst, size_t dstPitch,
+                        PixelLayout layout, Kernel kernel) const {
+    if (horizontal.taps.empty() || vertical.taps.empty()) return;
+    if (!supported(kernel)) kernel = best();
+
+    using HorizontalPass = void (*)(const uint8_t*, uint8_t*, int, int, Weights);
+    using VerticalPass = void (*)(const uint8_t*, size_t, int, Weights, uint8_t*, size_t, PixelLayout);
+    HorizontalPass horizontalPass = horizontalScalar;
+    VerticalPass verticalPass = verticalScalar;
+#ifdef IMAGE_SCALER_X86
+    if (kernel != Kernel::Scalar) horizontalPass = horizontalSSE2;
+    if (kernel == Kernel::SSE2) verticalPass = verticalSSE2;
+    if (kernel == Kernel::AVX2) verticalPass = verticalAVX2;
+#endif
+
+    // Pass 1: every source row to the target width
+    size_t rowBytes = 4 * static_cast<size_t>(dstW);
+    std::vector<uint8_t> columns(rowBytes * srcH);
+    for (int y = 0; y < srcH; y++) {
+        const uint8_t* row = src + y * srcPitch;
+        uint8_t* out = columns.data() + y * rowBytes;
+        for (int x = 0; x < dstW; x++) {
+            const Taps& taps = horizontal.taps[x];
+            horizontalPass(row, out + 4 * x, taps.start, taps.count, &horizontal.weights[taps.weights]);
+        }
+    }
+
+    // Pass 2: rows to the target height, with the channel order applied on the way out
+    for (int y = 0; y < dstH; y++) {
+        const Taps& taps = vertical.taps[y];
+        verticalPass(columns.data() + taps.start * rowBytes, rowBytes, taps.count,
+                     &vertical.weights[taps.weights], dst + y * dstPitch, rowBytes, layout);
+    }
+}
@@ -0,0 +1,94 @@
+#include "../include/LatencyTracer.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+void LatencyHistogram::record(std::chrono::nanoseconds value) {
+    uint64_t ns = value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0;
+    buckets[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    samples.fetch_add(1, std::memory_order_relaxed);
+    sumNs.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t seen = maxNs.load(std::memory_order_relaxed);
+    while (ns > seen && !maxNs.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {}
+}
+
+size_t LatencyHistogram::bucketOf(uint64_t ns) {
+    // Values below SUB_BUCKETS are exact; above, the top SUB_BITS + 1 bits select the bucket
+    if (ns < SUB_BUCKETS) return static_cast<size_t>(ns);
+    int msb = 63 - __builtin_clzll(ns);
+    int shift = msb - SUB_BITS;
+    return (static_cast<size_t>(shift) + 1) * SUB_BUCKETS + ((ns >> shift) & (SUB_BUCKETS - 1));
+}
+
+uint64_t LatencyHistogram::upperBound(size_t bucket) {
+    if (bucket < SUB_BUCKETS) return bucket;
+    int shift = static_cast<int>(bucket / SUB_BUCKETS) - 1;
+    uint64_t lower = (SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+std::chrono::nanoseconds LatencyHistogram::mean() const {
+    uint64_t n = count();
+    return std::chrono::nanoseconds(n ? sumNs.load(std::memory_order_relaxed) / n : 0);
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(double q) const {
+    uint64_t n = count();
+    if (n == 0) return std::chrono::nanoseconds::zero();
+
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(n) + 0.5);
+    rank = std::max<uint64_t>(1, std::min(rank, n));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKETS; bucket++) {
+        seen += buckets[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            // A bucket's upper bound may overshoot the real maximum
+            return std::chrono::nanoseconds(std::min(upperBound(bucket), maxNs.load(std::memory_order_relaxed)));
+        }
+    }
+    return max();
+}
+
+const char* LatencyTracer::name(TraceStage stage) {
+    switch (stage) {
+        case TraceStage::Udev:        return "udev";
+        case TraceStage::Intake:      return "intake";
+        case TraceStage::Scheduling:  return "scheduling";
+        case TraceStage::FirstFrame:  return "first frame";
+        case TraceStage::FirstAudio:  return "first audio";
+        case TraceStage::PlugToPixel: return "plug-pixel";
+        case TraceStage::PlugToSound: return "plug-sound";
+        default:                      return "?";
+    }
+}
+
+void LatencyTracer::dump(std::ostream& out) const {
+    auto ms = [](std::chrono::nanoseconds value) {
+        return std::chrono::duration<double, std::milli>(value).count();
+    };
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-12s %8s %9s %9s %9s %9s %9s %9s\n",
+                  "stage (ms)", "count", "p50", "p90", "p99", "p99.9", "max", "mean");
+    out << line;
+    for (size_t i = 0; i < stages.size(); i++) {
+        const LatencyHistogram& h = stages[i];
+        std::snprintf(line, sizeof(line), "%-12s %8llu %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+                      name(static_cast<TraceStage>(i)), static_cast<unsigned long long>(h.count()),
+                      ms(h.percentile(0.5)), ms(h.percentile(0.9)), ms(h.percentile(0.99)),
+                      ms(h.percentile(0.999)), ms(h.max()), ms(h.mean()));
+        out << line;
+    }
+}
+
+bool LatencyTracer::writeFile(const std::string& path) const {
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::trunc);
+        if (!file) return false;
+        dump(file);
+        if (!file.flush()) return false;
+    }
+    return std::rename(temp.c_str(), path.c_str()) == 0;
+}
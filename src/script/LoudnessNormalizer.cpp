@@ -0,0 +1,236 @@
+#include "../include/LoudnessNormalizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LOUDNESS_X86 1
+#endif
+
+namespace {
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double ABSOLUTE_GATE_LUFS = -70.0;
+    constexpr double RELATIVE_GATE_LU = -10.0;
+    constexpr int BLOCK_STEPS = 4; // 400 ms blocks advancing by 100 ms
+
+    /// Direct form I biquad, run in double precision.
+    struct Biquad {
+        double b0, b1, b2, a1, a2;
+        double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+        double operator()(double x) {
+            double y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+            x2 = x1; x1 = x;
+            y2 = y1; y1 = y;
+            return y;
+        }
+    };
+
+    // BS.1770 pre-filter (high shelf) and RLB high pass, re-derived for any sample rate
+    Biquad shelfFilter(int rate) {
+        const double f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+        double k = std::tan(PI * f0 / rate);
+        double vh = std::pow(10.0, gainDb / 20.0);
+        double vb = std::pow(vh, 0.4996667741545416);
+        double a0 = 1.0 + k / q + k * k;
+        return {(vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0,
+                2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0};
+    }
+
+    Biquad highPassFilter(int rate) {
+        const double f0 = 38.13547087602444, q = 0.5003270373238773;
+        double k = std::tan(PI * f0 / rate);
+        double a0 = 1.0 + k / q + k * k;
+        return {1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0};
+    }
+
+    inline double blockLoudness(double meanSquare) {
+        return meanSquare > 0 ? -0.691 + 10.0 * std::log10(meanSquare) : LoudnessAnalysis::SILENCE_DB;
+    }
+
+    inline int16_t limitScalar(int16_t sample, float gain, float ceiling) {
+        float v = std::min(std::max(static_cast<float>(sample) * gain, -ceiling), ceiling);
+        return static_cast<int16_t>(std::lrint(v));
+    }
+
+    void gainScalar(int16_t* samples, size_t count, float gain, float ceiling) {
+        for (size_t i = 0; i < count; i++) samples[i] = limitScalar(samples[i], gain, ceiling);
+    }
+
+#ifdef LOUDNESS_X86
+    // Same operations as the scalar path in the same order: multiply, clamp, round to nearest even
+    __attribute__((target("sse2")))
+    void gainSSE2(int16_t* samples, size_t count, float gain, float ceiling) {
+        const __m128 g = _mm_set1_ps(gain);
+        const __m128 hi = _mm_set1_ps(ceiling);
+        const __m128 lo = _mm_set1_ps(-ceiling);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+            // Sign-extend by placing each sample in the high half of a lane and shifting back
+            __m128 a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+            __m128 b = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+            a = _mm_max_ps(_mm_min_ps(_mm_mul_ps(a, g), hi), lo);
+            b = _mm_max_ps(_mm_min_ps(_mm_mul_ps(b, g), hi), lo);
+            __m128i out = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + i), out);
+        }
+        gainScalar(samples + i, count - i, gain, ceiling);
+    }
+
+    __attribute__((target("avx2")))
+    void gainAVX2(int16_t* samples, size_t count, float gain, float ceiling) {
+        const __m256 g = _mm256_set1_ps(gain);
+        const __m256 hi = _mm256_set1_ps(ceiling);
+        const __m256 lo = _mm256_set1_ps(-ceiling);
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+            __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i + 8));
+            __m256 a = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(x0));
+            __m256 b = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(x1));
+            a = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(a, g), hi), lo);
+            b = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(b, g), hi), lo);
+            // packs works per 128-bit lane: restore sample order across lanes afterwards
+            __m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+            packed = _mm256_permute4x64_epi64(packed, 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(samples + i), packed);
+        }
+        gainScalar(samples + i, count - i, gain, ceiling);
+    }
+#endif
+}
+
+LoudnessAnalysis LoudnessNormalizer::analyze(const int16_t* samples, size_t frames,
+                                                         int channels, int sampleRate) {
+    LoudnessAnalysis analysis;
+    if (!samples || frames == 0 || channels <= 0 || sampleRate <= 0) return analysis;
+
+    // K-weighted energy per 100 ms step, summed over channels
+    std::vector<Biquad> shelves(channels, shelfFilter(sampleRate));
+    std::vector<Biquad> highPasses(channels, highPassFilter(sampleRate));
+    size_t stepFrames = std::max<size_t>(static_cast<size_t>(sampleRate) / 10, 1);
+    std::vector<double> steps;
+    steps.reserve(frames / stepFrames + 1);
+
+    int peak = 0;
+    double energy = 0.0;
+    size_t inStep = 0;
+    for (size_t frame = 0; frame < frames; frame++) {
+        const int16_t* in = samples + frame * static_cast<size_t>(channels);
+        for (int c = 0; c < channels; c++) {
+            peak = std::max(peak, std::abs(static_cast<int>(in[c])));
+            double y = highPasses[c](shelves[c](in[c] / 32768.0));
+            energy += y * y;
+        }
+        if (++inStep == stepFrames) {
+            steps.push_back(energy);
+            energy = 0.0;
+            inStep = 0;
+        }
+    }
+    if (peak > 0) analysis.peakDbfs = 20.0 * std::log10(peak / 32768.0);
+
+    // Overlapping 400 ms blocks; a clip shorter than one block is one block
+    std::vector<double> blocks;
+    if (steps.size() < BLOCK_STEPS) {
+        double total = energy;
+        for (double step : steps) total += step;
+        blocks.push_back(total / static_cast<double>(frames));
+    } else {
+        double window = 0.0;
+        for (size_t i = 0; i < steps.size(); i++) {
+            window += steps[i];
+            if (i >= BLOCK_STEPS) window -= steps[i - BLOCK_STEPS];
+            if (i + 1 >= BLOCK_STEPS) blocks.push_back(window / static_cast<double>(BLOCK_STEPS * stepFrames));
+        }
+    }
+
+    // Absolute gate, then relative gate 10 LU under the loudness of what passed it
+    auto gatedMean = [&](double threshold) {
+        double sum = 0.0;
+        size_t count = 0;
+        for (double block : blocks) {
+            if (blockLoudness(block) > threshold) {
+                sum += block;
+                count++;
+            }
+        }
+        return count ? sum / static_cast<double>(count) : 0.0;
+    };
+    double ungated = gatedMean(ABSOLUTE_GATE_LUFS);
+    if (ungated <= 0) return analysis;
+    double relativeGate = std::max(blockLoudness(ungated) + RELATIVE_GATE_LU, ABSOLUTE_GATE_LUFS);
+    analysis.loudnessLufs = blockLoudness(gatedMean(relativeGate));
+    return analysis;
+}
+
+double LoudnessNormalizer::gainFor(const LoudnessAnalysis& analysis, const LoudnessTarget& target) {
+    if (analysis.loudnessLufs <= LoudnessAnalysis::SILENCE_DB || analysis.peakDbfs <= LoudnessAnalysis::SILENCE_DB)
+        return 0.0;
+
+    double gain = target.loudnessLufs - analysis.loudnessLufs;
+    gain = std::min(gain, target.maxGainDb);
+    // Only the top `maxLimitingDb` of the peaks may be clipped by the ceiling
+    return std::min(gain, target.ceilingDbfs + target.maxLimitingDb - analysis.peakDbfs);
+}
+
+int16_t LoudnessNormalizer::ceilingSample(double ceilingDbfs) {
+    double magnitude = std::round(32768.0 * std::pow(10.0, ceilingDbfs / 20.0));
+    return static_cast<int16_t>(std::clamp(magnitude, 1.0, 32767.0));
+}
+
+void LoudnessNormalizer::applyGain(int16_t* samples, size_t count, float gain, int16_t ceiling, Kernel kernel) {
+    if (!samples || count == 0) return;
+    if (!supported(kernel)) kernel = best();
+
+    using GainPass = void (*)(int16_t*, size_t, float, float);
+    GainPass pass = gainScalar;
+#ifdef LOUDNESS_X86
+    if (kernel == Kernel::SSE2) pass = gainSSE2;
+    if (kernel == Kernel::AVX2) pass = gainAVX2;
+#endif
+    pass(samples, count, gain, static_cast<float>(ceiling));
+}
+
+LoudnessNormalizer::Result LoudnessNormalizer::normalize(int16_t* samples, size_t frames, int channels,
+                                                         int sampleRate, const LoudnessTarget& target) {
+    Result result;
+    result.source = analyze(samples, frames, channels, sampleRate);
+    result.gainDb = gainFor(result.source, target);
+    result.kernel = best();
+
+    // Unity gain still goes through the kernel when the peaks sit above the ceiling: the clamp enforces it
+    if (result.gainDb != 0.0 || result.source.peakDbfs > target.ceilingDbfs) {
+        float gain = static_cast<float>(std::pow(10.0, result.gainDb / 20.0));
+        applyGain(samples, frames * static_cast<size_t>(channels), gain, ceilingSample(target.ceilingDbfs),
+                  result.kernel);
+    }
+    return result;
+}
+
+bool LoudnessNormalizer::supported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar: return true;
+#ifdef LOUDNESS_X86
+        case Kernel::SSE2: return __builtin_cpu_supports("sse2");
+        case Kernel::AVX2: return __builtin_cpu_supports("avx2");
+#endif
+        default: return false;
+    }
+}
+
+LoudnessNormalizer::Kernel LoudnessNormalizer::best() {
+    if (supported(Kernel::AVX2)) return Kernel::AVX2;
+    if (supported(Kernel::SSE2)) return Kernel::SSE2;
+    return Kernel::Scalar;
+}
+
+const char* LoudnessNormalizer::name(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::SSE2: return "SSE2";
+        case Kernel::AVX2: return "AVX2";
+        default: return "scalar";
+    }
+}
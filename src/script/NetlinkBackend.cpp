@@ -0,0 +1,180 @@
+#include "../include/NetlinkBackend.hpp"
+#include "../include/UdevBackend.hpp"
+#include "../include/Config.hpp"
+#include <linux/netlink.h>
+#include <linux/filter.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace {
+    // Big-endian words as loaded by BPF_LD (network byte order).
+    constexpr uint32_t WORD_DEVT = 0x44455654; // "DEVT"
+    constexpr uint32_t WORD_YPE = 0x5950453d;  // "YPE="
+    constexpr uint32_t WORD_USB_ = 0x7573625f; // "usb_"
+    constexpr uint32_t WORD_DEVI = 0x64657669; // "devi"
+    constexpr uint32_t HALF_CE = 0x6365;       // "ce"
+
+    sock_filter stmt(uint16_t code, uint32_t k) {
+        return sock_filter{code, 0, 0, k};
+    }
+
+    sock_filter jump(uint16_t code, uint32_t k, uint8_t jt, uint8_t jf) {
+        return sock_filter{code, jt, jf, k};
+    }
+}
+
+NetlinkBackend::NetlinkBackend() {
+    sock = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (sock < 0) {
+        std::cerr << "❌ Uevent socket creation failed: " << strerror(errno) << "\n";
+        return;
+    }
+
+    // Large buffer so bursts survive while the intake thread is scheduled out
+    int size = MonitorConfig::RECEIVE_BUFFER_BYTES;
+    if (setsockopt(sock, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) < 0)
+        setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+    if (!attachFilter()) {
+        std::cerr << "⚠️ BPF uevent filter not attached, filtering in userspace: " << strerror(errno) << "\n";
+    }
+
+    // Group 1 carries the kernel's own uevents (group 2 is udevd's re-broadcast)
+    sockaddr_nl addr{};
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = 1;
+    if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "❌ Uevent socket bind failed: " << strerror(errno) << "\n";
+        close(sock);
+        sock = -1;
+    }
+}
+
+NetlinkBackend::~NetlinkBackend() {
+    if (sock >= 0) close(sock);
+}
+
+bool NetlinkBackend::attachFilter() {
+    // For each offset i: if word[i] == "DEVT", X = i and jump to the shared tail.
+    // Loads past the end of a message abort the program, which drops the message.
+    std::vector<sock_filter> program;
+    program.reserve(SCAN_BYTES * 4 + 12);
+    const uint32_t tail = SCAN_BYTES * 4 + 1;
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(SCAN_BYTES); i++) {
+        uint32_t pc = static_cast<uint32_t>(program.size());
+        program.push_back(stmt(BPF_LD | BPF_W | BPF_ABS, i));
+        program.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, WORD_DEVT, 0, 2));
+        program.push_back(stmt(BPF_LDX | BPF_W | BPF_IMM, i));
+        program.push_back(stmt(BPF_JMP | BPF_JA, tail - (pc + 4)));
+    }
+    program.push_back(stmt(BPF_RET | BPF_K, 0));
+
+    // Tail: "DEVT" matched at X, require "YPE=usb_device\0"
+    program.push_back(stmt(BPF_LD | BPF_W | BPF_IND, 4));
+    program.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, WORD_YPE, 0, 9));
+    program.push_back(stmt(BPF_LD | BPF_W | BPF_IND, 8));
+    program.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, WORD_USB_, 0, 7));
+    program.push_back(stmt(BPF_LD | BPF_W | BPF_IND, 12));
+    program.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, WORD_DEVI, 0, 5));
+    program.push_back(stmt(BPF_LD | BPF_H | BPF_IND, 16));
+    program.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, HALF_CE, 0, 3));
+    program.push_back(stmt(BPF_LD | BPF_B | BPF_IND, 18));
+    program.push_back(jump(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
+    program.push_back(stmt(BPF_RET | BPF_K, 0xffffffff));
+    program.push_back(stmt(BPF_RET | BPF_K, 0));
+
+    sock_fprog fprog{static_cast<unsigned short>(program.size()), program.data()};
+    return setsockopt(sock, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) == 0;
+}
+
+bool NetlinkBackend::parse(const char* data, size_t size, KernelUevent& out) {
+    out = KernelUevent{};
+
+    // Kernel messages start with "ACTION@DEVPATH"; libudev ones with "libudev"
+    std::string_view header(data, strnlen(data, size));
+    if (header.find('@') == std::string_view::npos) return false;
+
+    size_t pos = header.size() + 1;
+    while (pos < size) {
+        std::string_view entry(data + pos, strnlen(data + pos, size - pos));
+        pos += entry.size() + 1;
+
+        size_t eq = entry.find('=');
+        if (eq == std::string_view::npos) continue;
+        std::string_view key = entry.substr(0, eq);
+        std::string_view value = entry.substr(eq + 1);
+
+        if (key == "ACTION") out.action = value;
+        else if (key == "DEVPATH") out.devpath = value;
+        else if (key == "SUBSYSTEM") out.subsystem = value;
+        else if (key == "DEVTYPE") out.devtype = value;
+        else if (key == "PRODUCT") out.product = value;
+        else if (key == "DEVNAME") out.devname = value;
+        else if (key == "BUSNUM") out.busnum = value;
+        else if (key == "DEVNUM") out.devnum = value;
+        else if (key == "SEQNUM") out.seqnum = value;
+    }
+    return !out.action.empty();
+}
+
+void NetlinkBackend::receive(const Callback& onEvent) {
+    if (sock < 0) return;
+
+    while (true) {
+        sockaddr_nl sender{};
+        iovec iov{buffer, sizeof(buffer)};
+        msghdr msg{};
+        msg.msg_name = &sender;
+        msg.msg_namelen = sizeof(sender);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+
+        ssize_t len = recvmsg(sock, &msg, 0);
+        if (len < 0) {
+            if (errno == EINTR) continue;
+            if (errno == ENOBUFS) {
+                std::cerr << "⚠️ Uevent socket overflow, events were lost\n";
+                continue;
+            }
+            return; // EAGAIN: drained
+        }
+
+        // Only trust messages sent by the kernel itself
+        if (sender.nl_pid != 0 || (msg.msg_flags & MSG_TRUNC)) continue;
+
+        KernelUevent uevent;
+        if (!parse(buffer, static_cast<size_t>(len), uevent)) continue;
+        if (uevent.subsystem != "usb" || uevent.devtype != "usb_device") continue;
+
+        UsbEvent event;
+        event.stamp();
+        // Straight from the kernel socket: receipt is the kernel event time
+        event.kernelAt = event.receivedAt;
+        event.seqnum = UsbEvent::parseUnsigned(uevent.seqnum);
+        event.action = UsbEvent::parseAction(uevent.action);
+        event.setIds(uevent.product);
+        event.busnum = UsbEvent::parseDecimal(uevent.busnum);
+        event.devnum = UsbEvent::parseDecimal(uevent.devnum);
+        event.setDevpath(uevent.devpath);
+
+        // DEVNAME is relative to /dev; build the node path in place
+        if (!uevent.devname.empty()) {
+            char node[UsbEvent::DEVNODE_CAPACITY];
+            int len = snprintf(node, sizeof(node), "/dev/%.*s",
+                               static_cast<int>(uevent.devname.size()), uevent.devname.data());
+            if (len > 0) event.setDevnode(std::string_view(node, std::min<size_t>(len, sizeof(node) - 1)));
+        }
+        onEvent(event);
+    }
+}
+
+size_t NetlinkBackend::enumerate(const Callback& onDevice) {
+    return UdevBackend::scanDevices(nullptr, onDevice);
+}
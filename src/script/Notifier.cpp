@@ -1,18 +1,77 @@
 #include "../include/Notifier.hpp"
 #include "../include/Config.hpp"
 #include "../include/SoundGenerator.hpp"
+#include "../include/AssetCache.hpp"
+#include "../include/FramePacer.hpp"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
+#include <SDL2/SDL_mixer.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
+#include <poll.h>
 #include <chrono>
 #include <thread>
 #include <iostream>
-#include <filesystem>
 #include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
 
-namespace fs = std::filesystem;
+Notifier::Notifier() {
+    configureAssets(AssetPaths{}, {});
+    warmFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (warmFd < 0) {
+        std::cerr << "⚠️ eventfd creation failed, the engine will be built synchronously: " << strerror(errno) << "\n";
+    }
+}
+
+Notifier::~Notifier() {
+    shutdown();
+    if (warmFd >= 0) close(warmFd);
+}
+
+bool Notifier::init() {
+    if (warming) return completeInit();
+    if (ready) return true;
+    if (!initVideo()) return false;
+    initAudio();
+    for (auto& cache : caches) cache->logFootprint();
+    ready = true;
+    return true;
+}
+
+bool Notifier::startInit() {
+    if (ready || warming) return true;
+    if (warmFd < 0) return init();
+    if (!initVideo()) return false;
 
-void Notifier::showMessage(const std::string& title, const std::string& message) const {
+    // Everything below blocks on PulseAudio or the decoder but not on the display: run it off this thread
+    sound.prepareEnvironment();
+    warming = true;
+    warmup = std::thread([this]() {
+        initAudio();
+        uint64_t one = 1;
+        ssize_t written = write(warmFd, &one, sizeof(one));
+        (void)written;
+    });
+    return true;
+}
+
+bool Notifier::completeInit() {
+    if (!warming) return ready;
+    warmup.join();
+    uint64_t done = 0;
+    ssize_t drained = read(warmFd, &done, sizeof(done));
+    (void)drained;
+    warming = false;
+
+    // The footprint queries textures, which belong to this thread, not the warm-up one
+    for (auto& cache : caches) cache->logFootprint();
+    ready = true;
+    return true;
+}
+
+bool Notifier::initVideo() {
     // Ensure graphical and audio environment variables exist for systemd user services
     if (!getenv("DISPLAY")) setenv("DISPLAY", ":0", 1);
     if (!getenv("XDG_RUNTIME_DIR")) setenv("XDG_RUNTIME_DIR", ("/run/user/" + std::to_string(getuid())).c_str(), 1);
@@ -21,81 +80,300 @@ void Notifier::showMessage(const std::string& title, const std::string& message)
     // Initialize SDL video subsystem
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         std::cerr << "❌ SDL video init failed: " << SDL_GetError() << "\n";
-        return;
+        return false;
     }
 
     // Initialize SDL_image for PNG/JPG support
     if (!(IMG_Init(IMG_INIT_PNG | IMG_INIT_JPG) & (IMG_INIT_PNG | IMG_INIT_JPG))) {
         std::cerr << "❌ SDL_image init failed: " << IMG_GetError() << "\n";
         SDL_Quit();
-        return;
+        return false;
     }
 
-    // Load background image (auto-resolves installed vs dev path)
-    std::string imgPath = DisplayConfig::getBackgroundPath();
-    if (!fs::exists(imgPath)) {
-        std::cerr << "⚠️ Background not found: " << imgPath << "\n";
+    // One borderless window per display, created once and hidden until an alert arrives
+    int displays = std::max(SDL_GetNumVideoDisplays(), 1);
+    for (int display = 0; display < displays; display++) {
+        Screen screen;
+        screen.display = display;
+        if (openScreen(screen, screens.empty())) screens.push_back(screen);
     }
+    if (screens.empty()) {
+        IMG_Quit(); SDL_Quit();
+        return false;
+    }
+
+    SDL_RendererInfo info;
+    vsync = SDL_GetRendererInfo(screens.front().renderer, &info) == 0 && (info.flags & SDL_RENDERER_PRESENTVSYNC);
 
-    // Create fullscreen borderless window
     SDL_DisplayMode dm;
-    SDL_GetCurrentDisplayMode(0, &dm);
-    SDL_Window* window = SDL_CreateWindow(
-        title.c_str(),
-        SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-        dm.w, dm.h,
-        SDL_WINDOW_SHOWN | SDL_WINDOW_BORDERLESS
+    int refreshHz = SDL_GetCurrentDisplayMode(screens.front().display, &dm) == 0 && dm.refresh_rate > 0
+        ? dm.refresh_rate : 60;
+    refreshPeriod = std::chrono::nanoseconds(1000000000 / refreshHz);
+    std::cout << "🖥️ " << screens.size() << " display(s), " << (vsync ? "vsync-paced at " : "timer-paced, display at ")
+              << refreshHz << " Hz\n";
+
+    // Textures belong to this thread; the sounds are decoded by initAudio()
+    for (auto& cache : caches) cache->loadImages(renderers());
+    caption.load(renderers());
+    return true;
+}
+
+void Notifier::initAudio() {
+    // Open the audio device once, then decode every alert once
+    if (!sound.init(audioBuffer, audioVoices)) {
+        std::cerr << "⚠️ Sound system initialization failed.\n";
+    }
+    for (auto& cache : caches) cache->loadSound();
+}
+
+bool Notifier::openScreen(Screen& screen, bool paced) {
+    SDL_Rect bounds;
+    if (SDL_GetDisplayBounds(screen.display, &bounds) < 0) {
+        std::cerr << "⚠️ Display " << screen.display << " unavailable: " << SDL_GetError() << "\n";
+        return false;
+    }
+
+    screen.window = SDL_CreateWindow(
+        "USB Moaner",
+        bounds.x, bounds.y,
+        bounds.w, bounds.h,
+        SDL_WINDOW_HIDDEN | SDL_WINDOW_BORDERLESS
     );
-    if (!window) {
-        std::cerr << "❌ SDL window creation failed: " << SDL_GetError() << "\n";
-        IMG_Quit(); SDL_Quit();
-        return;
+    if (!screen.window) {
+        std::cerr << "❌ SDL window creation failed on display " << screen.display << ": " << SDL_GetError() << "\n";
+        return false;
     }
 
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    // Only the pacing screen waits for vblank, so a frame never costs one vblank per display.
+    // Prefer vblank-synchronized presents there; not every driver offers them.
+    if (FadeConfig::VSYNC && paced)
+        screen.renderer = SDL_CreateRenderer(screen.window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!screen.renderer) screen.renderer = SDL_CreateRenderer(screen.window, -1, SDL_RENDERER_ACCELERATED);
+    if (!screen.renderer) {
+        std::cerr << "❌ SDL renderer creation failed on display " << screen.display << ": " << SDL_GetError() << "\n";
+        SDL_DestroyWindow(screen.window);
+        screen.window = nullptr;
+        return false;
+    }
+    SDL_SetRenderDrawBlendMode(screen.renderer, SDL_BLENDMODE_BLEND);
+    return true;
+}
 
-    // Try loading texture from background image
-    SDL_Surface* surface = IMG_Load(imgPath.c_str());
-    SDL_Texture* texture = nullptr;
-    bool hasImage = false;
+std::vector<SDL_Renderer*> Notifier::renderers() const {
+    std::vector<SDL_Renderer*> out;
+    for (const Screen& screen : screens) out.push_back(screen.renderer);
+    return out;
+}
 
-    if (surface) {
-        texture = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_FreeSurface(surface);
-        if (texture) {
-            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-            hasImage = true;
+void Notifier::drawFrame(uint8_t alpha) {
+    // Same opacity on every screen; all of them are drawn before anything is presented
+    for (size_t i = 0; i < screens.size(); i++) {
+        SDL_Renderer* renderer = screens[i].renderer;
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        if (SDL_Texture* texture = current->background(i)) {
+            SDL_SetTextureAlphaMod(texture, alpha);
+            SDL_RenderCopy(renderer, texture, nullptr, nullptr);
         } else {
-            std::cerr << "⚠️ Failed to create texture from image: " << SDL_GetError() << "\n";
+            SDL_SetRenderDrawColor(renderer, 255, 0, 90, alpha);
+            SDL_RenderFillRect(renderer, nullptr);
         }
+        caption.draw(i, alpha);
     }
 
-    // Display first frame (background or fallback color)
-    SDL_RenderClear(renderer);
-    if (hasImage)
-        SDL_RenderCopy(renderer, texture, nullptr, nullptr);
-    else {
-        SDL_SetRenderDrawColor(renderer, 255, 0, 90, 255);
-        SDL_RenderFillRect(renderer, nullptr);
-    }
-    SDL_RenderPresent(renderer);
-
-    // Launch sound playback in detached thread
-    SoundGenerator sound("NotifierSound");
-    if (sound.init()) {
-        std::string soundPath = AudioConfig::getSoundPath();
-        if (fs::exists(soundPath)) {
-            std::thread([&sound, soundPath]() {
-                sound.play(soundPath, AudioConfig::VOLUME_PERCENT);
-            }).detach();
-        } else {
-            std::cerr << "⚠️ Sound file missing: " << soundPath << "\n";
-        }
-    } else {
-        std::cerr << "⚠️ Sound system initialization failed.\n";
+    // Non-blocking presents first, the vsync-paced one last
+    auto presentStart = std::chrono::steady_clock::now();
+    for (size_t i = screens.size(); i-- > 0;) SDL_RenderPresent(screens[i].renderer);
+    lastFrameAt = std::chrono::steady_clock::now();
+
+    double ms = std::chrono::duration<double, std::milli>(lastFrameAt - presentStart).count();
+    frames.lastPresentMs = ms;
+    frames.maxPresentMs = std::max(frames.maxPresentMs, ms);
+    frames.totalPresentMs += ms;
+    frames.frames++;
+}
+
+void Notifier::recordFade(std::chrono::steady_clock::time_point now) {
+    double ms = std::chrono::duration<double, std::milli>(now - fadeStartAt).count();
+    frames.lastFadeMs = ms;
+    frames.maxFadeMs = std::max(frames.maxFadeMs, ms);
+    frames.fades++;
+
+    std::cout << "🎞️ Fade: " << fadeFrames << " frames in " << ms << " ms ("
+              << (vsync ? "vsync" : "timer") << "), present avg " << frames.averagePresentMs()
+              << " ms / max " << frames.maxPresentMs << " ms, missed deadlines "
+              << frames.missedDeadlines << "\n";
+}
+
+std::chrono::nanoseconds Notifier::frameInterval() const {
+    return vsync ? refreshPeriod : frameDelay;
+}
+
+void Notifier::recordFirstFrame(std::chrono::steady_clock::time_point triggeredAt) {
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - triggeredAt).count();
+
+    latency.lastMs = ms;
+    latency.minMs = latency.samples ? std::min(latency.minMs, ms) : ms;
+    latency.maxMs = latency.samples ? std::max(latency.maxMs, ms) : ms;
+    latency.totalMs += ms;
+    latency.samples++;
+
+    std::cout << "⏱️ Plug-to-first-frame: " << ms << " ms (avg "
+              << latency.averageMs() << " ms over " << latency.samples << ")\n";
+}
+
+void Notifier::configureAudio(int bufferSamples, int voices) {
+    audioBuffer = bufferSamples;
+    audioVoices = voices;
+}
+
+bool Notifier::configureAssets(const AssetPaths& defaults, const std::vector<AssetPaths>& sets) {
+    // The caches must not change under the warm-up thread
+    if (warming) completeInit();
+
+    auto samePaths = [](const AssetPaths& a, const AssetPaths& b) {
+        return a.background == b.background && a.sound == b.sound;
+    };
+    if (!cachePaths.empty() && samePaths(cachePaths.front(), defaults) &&
+        std::equal(cachePaths.begin() + 1, cachePaths.end(), sets.begin(), sets.end(), samePaths))
+        return false;
+
+    cachePaths.assign(1, defaults);
+    cachePaths.insert(cachePaths.end(), sets.begin(), sets.end());
+    caches.clear();
+    caches.push_back(std::make_unique<AssetCache>(defaults));
+    for (const AssetPaths& paths : sets) caches.push_back(std::make_unique<AssetCache>(paths));
+    current = caches.front().get();
+
+    // Already running: decode now rather than on the next alert
+    if (ready) {
+        for (auto& cache : caches) cache->load(renderers());
+    }
+    return true;
+}
+
+bool Notifier::begin(const char* title, const char* message,
+                     std::chrono::steady_clock::time_point triggeredAt,
+                     const AlertStyle& style) {
+    if (!init()) return false;
+
+    bool custom = style.assetSet >= 0 && static_cast<size_t>(style.assetSet) + 1 < caches.size();
+    current = caches[custom ? style.assetSet + 1 : 0].get();
+
+    // Same wall duration as the nominal fixed-step fade, whatever the real frame rate
+    int speed = style.fadeSpeed > 0 ? style.fadeSpeed : FadeConfig::FADE_SPEED;
+    int frameMs = style.frameDelayMs > 0 ? style.frameDelayMs : FadeConfig::FRAME_DELAY_MS;
+    frameDelay = std::chrono::milliseconds(frameMs);
+    fadeDuration = frameDelay * ((255 + speed - 1) / speed);
+    int volume = style.volumePercent;
+    int priority = style.priority;
+    caption.layout(message);
+
+    // Reveal the pre-built overlay and display the first frame (background or fallback color)
+    for (const Screen& screen : screens) {
+        SDL_SetWindowTitle(screen.window, title);
+        SDL_ShowWindow(screen.window);
+        SDL_RaiseWindow(screen.window);
+    }
+    timing.shownAt = std::chrono::steady_clock::now();
+    drawFrame(255);
+    timing.firstFrameAt = lastFrameAt;
+    recordFirstFrame(triggeredAt);
+    fadeStartAt = lastFrameAt + std::chrono::milliseconds(std::max(style.fadeDelayMs, 0));
+    fadeFrames = 0;
+    alpha = 255;
+    fading = true;
+
+    // Start the cached alert; completion comes back through audioFd()
+    if (Mix_Chunk* chunk = current->alert()) sound.play(chunk, volume, priority);
+    return true;
+}
+
+bool Notifier::advanceFade() {
+    if (!fading) return false;
+
+    SDL_PumpEvents();
+    auto now = std::chrono::steady_clock::now();
+    if (now < fadeStartAt) return true;
+
+    // More than half a period late counts as a missed frame
+    if (fadeFrames > 0 && now - lastFrameAt > frameInterval() * 3 / 2) frames.missedDeadlines++;
+
+    // Opacity follows the clock, not the number of frames drawn
+    auto elapsed = now - fadeStartAt;
+    alpha = elapsed >= fadeDuration ? 0 : static_cast<uint8_t>(
+        255 - 255 * std::chrono::duration<double>(elapsed) / std::chrono::duration<double>(fadeDuration));
+    drawFrame(alpha);
+    fadeFrames++;
+
+    if (alpha == 0) {
+        recordFade(lastFrameAt);
+        finish();
+    }
+    return fading;
+}
+
+void Notifier::finish() {
+    if (!fading) return;
+
+    // Hide the overlay again; window, renderer and assets stay alive for the next alert
+    for (const Screen& screen : screens) SDL_HideWindow(screen.window);
+    SDL_PumpEvents();
+    fading = false;
+}
+
+void Notifier::showMessage(const char* title, const char* message,
+                           std::chrono::steady_clock::time_point triggeredAt) {
+    if (!begin(title, message, triggeredAt)) return;
+
+    // Fade-out animation: vsync presents pace themselves, otherwise sleep to absolute deadlines
+    std::this_thread::sleep_until(fadeStartAt);
+    FramePacer pacer(frameInterval());
+    pacer.start();
+    while (advanceFade()) {
+        if (!vsync) pacer.wait();
+    }
+
+    // Let the sound end too, so other streams are restored before returning
+    pollfd completion{sound.completionFd(), POLLIN, 0};
+    while (sound.playingVoices() > 0 && poll(&completion, 1, -1) > 0) sound.onChannelsFinished();
+}
+
+bool Notifier::reloadAssets() {
+    if (!ready) return false;
+    bool any = false;
+    for (auto& cache : caches) any = cache->reload() || any;
+    return any;
+}
+
+AssetFootprint Notifier::assetFootprint() const {
+    AssetFootprint total;
+    for (const auto& cache : caches) {
+        AssetFootprint fp = cache->footprint();
+        total.surfaceBytes += fp.surfaceBytes;
+        total.textureBytes += fp.textureBytes;
+        total.pcmBytes += fp.pcmBytes;
+    }
+    return total;
+}
+
+void Notifier::shutdown() {
+    if (warming) completeInit();
+    if (!ready) return;
+    finish();
+
+    // Textures and chunks must go before their renderer and audio device
+    for (auto& cache : caches) cache->release();
+    caption.release();
+    sound.cleanup();
+    for (const Screen& screen : screens) {
+        SDL_DestroyRenderer(screen.renderer);
+        SDL_DestroyWindow(screen.window);
     }
+    screens.clear();
 
-    // Fade-out animation
-    std::this_thread::sleep_for(std::chrono::milliseconds(FadeConfig::DELAY_BEFORE_FADE_MS));
-    Uint
+    IMG_Quit();
+    SDL_Quit();
+    ready = false;
+}
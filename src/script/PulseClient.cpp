@@ -0,0 +1,198 @@
+#include "../include/PulseClient.hpp"
+#include <pulse/pulseaudio.h>
+#include <iostream>
+#include <algorithm>
+
+namespace {
+    // Wakes the thread waiting in PulseClient::connect() on every state change.
+    void onContextState(pa_context*, void* userdata) {
+        pa_threaded_mainloop_signal(static_cast<pa_threaded_mainloop*>(userdata), 0);
+    }
+
+    // Generic completion callback for mute requests.
+    void onSuccess(pa_context*, int, void* userdata) {
+        pa_threaded_mainloop_signal(static_cast<pa_threaded_mainloop*>(userdata), 0);
+    }
+
+    // Accumulates sink-inputs until the end-of-list marker arrives.
+    struct SinkInputQuery {
+        pa_threaded_mainloop* mainloop;
+        std::vector<PulseClient::SinkInput>* out;
+    };
+
+    void onSinkInputInfo(pa_context*, const pa_sink_input_info* info, int eol, void* userdata) {
+        auto* query = static_cast<SinkInputQuery*>(userdata);
+        if (eol || !info) {
+            pa_threaded_mainloop_signal(query->mainloop, 0);
+            return;
+        }
+        const char* app = info->proplist ? pa_proplist_gets(info->proplist, PA_PROP_APPLICATION_NAME) : nullptr;
+        query->out->push_back({info->index, info->mute != 0, app ? app : ""});
+    }
+}
+
+PulseClient::PulseClient(const std::string& clientName)
+    : name(clientName) {}
+
+PulseClient::~PulseClient() {
+    disconnect();
+}
+
+bool PulseClient::connect() {
+    if (isReady()) return true;
+    disconnect();
+
+    mainloop = pa_threaded_mainloop_new();
+    if (!mainloop) {
+        std::cerr << "❌ PulseAudio mainloop creation failed\n";
+        return false;
+    }
+
+    // NULL e.g. after libpulse detected a fork; its setters would assert on it
+    context = pa_context_new(pa_threaded_mainloop_get_api(mainloop), name.c_str());
+    if (!context) {
+        std::cerr << "❌ PulseAudio context creation failed\n";
+        pa_threaded_mainloop_free(mainloop);
+        mainloop = nullptr;
+        return false;
+    }
+    pa_context_set_state_callback(context, onContextState, mainloop);
+
+    pa_threaded_mainloop_lock(mainloop);
+    if (pa_threaded_mainloop_start(mainloop) < 0 ||
+        pa_context_connect(context, nullptr, PA_CONTEXT_NOAUTOSPAWN, nullptr) < 0) {
+        std::cerr << "❌ PulseAudio connection failed: " << pa_strerror(pa_context_errno(context)) << "\n";
+        pa_threaded_mainloop_unlock(mainloop);
+        disconnect();
+        return false;
+    }
+
+    // Wait until the context is ready or has definitively failed
+    while (true) {
+        pa_context_state_t state = pa_context_get_state(context);
+        if (state == PA_CONTEXT_READY) break;
+        if (!PA_CONTEXT_IS_GOOD(state)) {
+            std::cerr << "❌ PulseAudio connection failed: " << pa_strerror(pa_context_errno(context)) << "\n";
+            pa_threaded_mainloop_unlock(mainloop);
+            disconnect();
+            return false;
+        }
+        pa_threaded_mainloop_wait(mainloop);
+    }
+
+    // Be told about new streams instead of polling for them
+    pa_context_set_subscribe_callback(context,
+        [](pa_context* c, pa_subscription_event_type_t type, uint32_t index, void* self) {
+            onSubscription(c, type, index, self);
+        }, this);
+    await(pa_context_subscribe(context, PA_SUBSCRIPTION_MASK_SINK_INPUT, onSuccess, mainloop));
+    pa_threaded_mainloop_unlock(mainloop);
+    return true;
+}
+
+void PulseClient::onSubscription(pa_context*, int type, uint32_t, void* userdata) {
+    auto* self = static_cast<PulseClient*>(userdata);
+    if ((type & PA_SUBSCRIPTION_EVENT_FACILITY_MASK) != PA_SUBSCRIPTION_EVENT_SINK_INPUT ||
+        (type & PA_SUBSCRIPTION_EVENT_TYPE_MASK) != PA_SUBSCRIPTION_EVENT_NEW) return;
+
+    {
+        std::lock_guard<std::mutex> lock(self->streamMutex);
+        self->streamsAdded++;
+    }
+    self->streamAdded.notify_all();
+}
+
+void PulseClient::disconnect() {
+    if (mainloop) pa_threaded_mainloop_stop(mainloop);
+    if (context) {
+        pa_context_disconnect(context);
+        pa_context_unref(context);
+        context = nullptr;
+    }
+    if (mainloop) {
+        pa_threaded_mainloop_free(mainloop);
+        mainloop = nullptr;
+    }
+    mutedByUs.clear();
+}
+
+bool PulseClient::isReady() const {
+    return context && pa_context_get_state(context) == PA_CONTEXT_READY;
+}
+
+void PulseClient::await(pa_operation* op) {
+    if (!op) return;
+    while (pa_operation_get_state(op) == PA_OPERATION_RUNNING)
+        pa_threaded_mainloop_wait(mainloop);
+    pa_operation_unref(op);
+}
+
+std::vector<PulseClient::SinkInput> PulseClient::listSinkInputs() {
+    std::vector<SinkInput> inputs;
+    SinkInputQuery query{mainloop, &inputs};
+    await(pa_context_get_sink_input_info_list(context, onSinkInputInfo, &query));
+    return inputs;
+}
+
+int64_t PulseClient::findStream(const std::string& appName) {
+    if (!isReady()) return -1;
+
+    pa_threaded_mainloop_lock(mainloop);
+    std::vector<SinkInput> inputs = listSinkInputs();
+    pa_threaded_mainloop_unlock(mainloop);
+
+    for (const SinkInput& input : inputs) {
+        if (input.appName == appName) return input.index;
+    }
+    return -1;
+}
+
+int64_t PulseClient::awaitStream(const std::string& appName, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        // Sample the counter before querying, so a stream added meanwhile is not missed
+        uint64_t seen;
+        {
+            std::lock_guard<std::mutex> lock(streamMutex);
+            seen = streamsAdded;
+        }
+
+        int64_t id = findStream(appName);
+        if (id != -1 || !isReady()) return id;
+
+        std::unique_lock<std::mutex> lock(streamMutex);
+        if (!streamAdded.wait_until(lock, deadline, [&]() { return streamsAdded != seen; })) return -1;
+    }
+}
+
+void PulseClient::muteAllExcept(uint32_t keepId) {
+    if (!isReady()) return;
+
+    pa_threaded_mainloop_lock(mainloop);
+    std::vector<SinkInput> inputs = listSinkInputs();
+
+    // Fire every mute request first, then wait for all of them together
+    std::vector<pa_operation*> ops;
+    for (const SinkInput& input : inputs) {
+        if (input.index == keepId || input.muted) continue;
+        ops.push_back(pa_context_set_sink_input_mute(context, input.index, 1, onSuccess, mainloop));
+        mutedByUs.push_back(input.index);
+    }
+    for (pa_operation* op : ops) await(op);
+    pa_threaded_mainloop_unlock(mainloop);
+}
+
+void PulseClient::restoreAll() {
+    if (!isReady() || mutedByUs.empty()) return;
+
+    pa_threaded_mainloop_lock(mainloop);
+    std::vector<pa_operation*> ops;
+    for (uint32_t index : mutedByUs) {
+        // Streams that vanished in the meantime simply fail; nothing to undo
+        ops.push_back(pa_context_set_sink_input_mute(context, index, 0, onSuccess, mainloop));
+    }
+    for (pa_operation* op : ops) await(op);
+    pa_threaded_mainloop_unlock(mainloop);
+
+    mutedByUs.clear();
+}
@@ -0,0 +1,136 @@
+#include "../include/RateLimiter.hpp"
+#include "../include/Config.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+    // How often idle devices are swept out of the table.
+    constexpr std::chrono::seconds PRUNE_INTERVAL(60);
+}
+
+TokenBucket::TokenBucket(double burst, double refillPerSec, Clock::time_point now)
+    : burst(burst), refillPerSec(refillPerSec), tokens(burst), updatedAt(now) {}
+
+double TokenBucket::available(Clock::time_point now) const {
+    double elapsed = std::chrono::duration<double>(now - updatedAt).count();
+    return std::min(burst, tokens + std::max(0.0, elapsed) * refillPerSec);
+}
+
+bool TokenBucket::tryTake(Clock::time_point now) {
+    tokens = available(now);
+    updatedAt = now;
+    if (tokens < 1.0) return false;
+    tokens -= 1.0;
+    return true;
+}
+
+bool TokenBucket::full(Clock::time_point now) const {
+    return available(now) >= burst;
+}
+
+void TokenBucket::reset(Clock::time_point now) {
+    tokens = burst;
+    updatedAt = now;
+}
+
+RateLimiter::RateLimiter()
+    : global(RateLimitConfig::GLOBAL_BURST, RateLimitConfig::GLOBAL_REFILL_PER_SEC, Clock::now()),
+      nextPrune(Clock::now() + PRUNE_INTERVAL) {}
+
+RateLimiter::Verdict RateLimiter::allow(const UsbEvent& event, Clock::time_point now) {
+    if (now >= nextPrune) prune(now);
+
+    // Formatted on the stack; keyBuffer keeps its capacity, so lookups never allocate
+    char key[UsbEvent::ID_TEXT_SIZE + UsbEvent::DEVPATH_CAPACITY + 1];
+    int keyLength = snprintf(key, sizeof(key), "%04x:%04x:%s", event.vendor, event.product, event.devpath);
+    keyBuffer.assign(key, std::min<size_t>(std::max(keyLength, 0), sizeof(key) - 1));
+    auto it = devices.find(keyBuffer);
+    if (it == devices.end()) {
+        DeviceState fresh{TokenBucket(RateLimitConfig::DEVICE_BURST, RateLimitConfig::DEVICE_REFILL_PER_SEC, now)};
+        it = devices.emplace(keyBuffer, fresh).first;
+        trackedCount.store(devices.size(), std::memory_order_relaxed);
+    }
+    const std::string& deviceKey = it->first;
+    DeviceState& state = it->second;
+
+    // Quarantined devices are dropped without touching any bucket
+    if (state.quarantinedUntil != Clock::time_point{}) {
+        if (now < state.quarantinedUntil) {
+            state.suppressed++;
+            quarantineDropCount.fetch_add(1, std::memory_order_relaxed);
+            return Verdict::Quarantined;
+        }
+        std::cout << "✅ Quarantine lifted for " << deviceKey << " (" << state.suppressed
+                  << " events suppressed)\n";
+        state.quarantinedUntil = Clock::time_point{};
+        state.suppressed = 0;
+        state.rejectStreak = 0;
+        state.bucket.reset(now);
+        quarantinedCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    if (!state.bucket.tryTake(now)) return reject(deviceKey, state, Verdict::DeviceLimit, now);
+    if (!global.tryTake(now)) return reject(deviceKey, state, Verdict::GlobalLimit, now);
+
+    if (state.suppressed > 0) {
+        std::cout << "⏳ " << deviceKey << ": " << state.suppressed << " events rate-limited since last alert\n";
+        state.suppressed = 0;
+    }
+    state.rejectStreak = 0;
+    allowedCount.fetch_add(1, std::memory_order_relaxed);
+    return Verdict::Allow;
+}
+
+RateLimiter::Verdict RateLimiter::reject(const std::string& key, DeviceState& state,
+                                         Verdict reason, Clock::time_point now) {
+    state.suppressed++;
+    if (reason == Verdict::DeviceLimit)
+        deviceLimitedCount.fetch_add(1, std::memory_order_relaxed);
+    else
+        globalLimitedCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Only the device's own excess counts towards quarantine, not global pressure
+    if (reason == Verdict::DeviceLimit && ++state.rejectStreak >= RateLimitConfig::QUARANTINE_AFTER) {
+        state.quarantinedUntil = now + std::chrono::milliseconds(RateLimitConfig::QUARANTINE_MS);
+        quarantineCount.fetch_add(1, std::memory_order_relaxed);
+        quarantinedCount.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "🚫 Quarantining flapping device " << key << " for "
+                  << RateLimitConfig::QUARANTINE_MS / 1000 << "s (" << state.suppressed
+                  << " events suppressed so far)\n";
+    }
+    return reason;
+}
+
+void RateLimiter::prune(Clock::time_point now) {
+    for (auto it = devices.begin(); it != devices.end();) {
+        DeviceState& state = it->second;
+        bool quarantined = state.quarantinedUntil != Clock::time_point{};
+        if (quarantined && now < state.quarantinedUntil) { ++it; continue; }
+        if (!quarantined && !state.bucket.full(now)) { ++it; continue; }
+
+        // Expired quarantine or idle device: summarize what was held back and forget it
+        if (quarantined) {
+            quarantinedCount.fetch_sub(1, std::memory_order_relaxed);
+            std::cout << "✅ Quarantine lifted for " << it->first << " (" << state.suppressed
+                      << " events suppressed)\n";
+        } else if (state.suppressed > 0) {
+            std::cout << "⏳ " << it->first << ": " << state.suppressed << " events rate-limited, device now idle\n";
+        }
+        it = devices.erase(it);
+    }
+    trackedCount.store(devices.size(), std::memory_order_relaxed);
+    nextPrune = now + PRUNE_INTERVAL;
+}
+
+RateLimiterStats RateLimiter::stats() const {
+    RateLimiterStats s;
+    s.allowed = allowedCount.load(std::memory_order_relaxed);
+    s.deviceLimited = deviceLimitedCount.load(std::memory_order_relaxed);
+    s.globalLimited = globalLimitedCount.load(std::memory_order_relaxed);
+    s.quarantineDrops = quarantineDropCount.load(std::memory_order_relaxed);
+    s.quarantines = quarantineCount.load(std::memory_order_relaxed);
+    s.trackedDevices = trackedCount.load(std::memory_order_relaxed);
+    s.quarantinedDevices = quarantinedCount.load(std::memory_order_relaxed);
+    return s;
+}
@@ -0,0 +1,295 @@
+#include "../include/RuleEngine.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+    const RuleAction DEFAULT_ACTION{};
+
+    // Fibonacci hashing: the high bits of the product are well mixed.
+    inline uint32_t hashKey(uint32_t key) {
+        return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> 32);
+    }
+
+    // Splits "a,b,c" into three positive integers.
+    bool parseFade(const std::string& text, RuleAction& action) {
+        int delay = 0, speed = 0, frame = 0;
+        char extra = 0;
+        if (sscanf(text.c_str(), "%d,%d,%d%c", &delay, &speed, &frame, &extra) != 3) return false;
+        if (delay < 0 || speed <= 0 || speed > 255 || frame <= 0) return false;
+        action.fadeDelayMs = delay;
+        action.fadeSpeed = speed;
+        action.frameDelayMs = frame;
+        return true;
+    }
+}
+
+bool RuleEngine::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        if (std::filesystem::exists(path))
+            std::cerr << "⚠️ Could not read rules file: " << path << "\n";
+        std::istringstream none;
+        load(none, path);
+        return false;
+    }
+    load(in, path);
+    return true;
+}
+
+void RuleEngine::load(std::istream& in, const std::string& origin) {
+    std::vector<Rule> rules;
+    assets.clear();
+
+    std::string line, error;
+    for (int number = 1; std::getline(in, line); number++) {
+        line.erase(std::find(line.begin(), line.end(), '#'), line.end());
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        Rule rule;
+        if (parseLine(line, number, rule, error)) {
+            rules.push_back(std::move(rule));
+        } else {
+            std::cerr << "⚠️ " << origin << ":" << number << ": " << error << ", rule skipped\n";
+        }
+    }
+
+    compile(rules);
+    if (!rules.empty())
+        std::cout << "📜 Loaded " << rules.size() << " device rule(s) from " << origin << "\n";
+}
+
+bool RuleEngine::parseLine(const std::string& line, int number, Rule& out, std::string& error) {
+    std::istringstream tokens(line);
+    std::string match;
+    tokens >> match;
+
+    // Device match: "vid:pid", "vid:*" or "*:*" (a lone "*" means any device)
+    if (match == "*") match = "*:*";
+    size_t colon = match.find(':');
+    if (colon == std::string::npos) {
+        error = "expected vendor:product, got '" + match + "'";
+        return false;
+    }
+    std::string vendor = match.substr(0, colon);
+    std::string product = match.substr(colon + 1);
+    uint16_t vid = 0, pid = 0;
+
+    if (vendor == "*") {
+        if (product != "*") {
+            error = "a product ID needs a vendor ID";
+            return false;
+        }
+        out.tier = Tier::Any;
+        out.key = 0;
+    } else if (!UsbEvent::parseHex(vendor, vid)) {
+        error = "invalid vendor ID '" + vendor + "'";
+        return false;
+    } else if (product == "*") {
+        out.tier = Tier::Vendor;
+        out.key = vid;
+    } else if (!UsbEvent::parseHex(product, pid)) {
+        error = "invalid product ID '" + product + "'";
+        return false;
+    } else {
+        out.tier = Tier::Exact;
+        out.key = pack(vid, pid);
+    }
+    out.line = number;
+
+    AssetPaths paths;
+    std::string token;
+    while (tokens >> token) {
+        size_t eq = token.find('=');
+        std::string name = token.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : token.substr(eq + 1);
+
+        if (token == "alert") out.action.kind = RuleAction::Kind::Alert;
+        else if (token == "silent") out.action.kind = RuleAction::Kind::Silent;
+        else if (token == "ignore") out.action.kind = RuleAction::Kind::Ignore;
+        else if (name == "devpath" && !value.empty()) out.devpathPrefix = value;
+        else if (name == "background" && !value.empty()) paths.background = value;
+        else if (name == "sound" && !value.empty()) paths.sound = value;
+        else if (name == "priority") {
+            try {
+                size_t used = 0;
+                out.action.priority = std::stoi(value, &used);
+                if (used != value.size()) throw std::invalid_argument(value);
+            } catch (const std::exception&) {
+                error = "invalid priority '" + value + "'";
+                return false;
+            }
+        } else if (name == "fade") {
+            if (!parseFade(value, out.action)) {
+                error = "invalid fade '" + value + "', expected DELAY_MS,SPEED,FRAME_MS";
+                return false;
+            }
+        } else {
+            error = "unknown action '" + token + "'";
+            return false;
+        }
+    }
+
+    // Share one asset set between every rule using the same files
+    if (!paths.background.empty() || !paths.sound.empty()) {
+        auto it = std::find_if(assets.begin(), assets.end(), [&](const AssetPaths& p) {
+            return p.background == paths.background && p.sound == paths.sound;
+        });
+        out.action.assetSet = static_cast<int>(it - assets.begin());
+        if (it == assets.end()) assets.push_back(paths);
+    }
+    return true;
+}
+
+void RuleEngine::compile(std::vector<Rule>& rules) {
+    // Group by tier and key; within a key the longest prefix wins, then the earliest line
+    std::sort(rules.begin(), rules.end(), [](const Rule& a, const Rule& b) {
+        if (a.tier != b.tier) return a.tier < b.tier;
+        if (a.key != b.key) return a.key < b.key;
+        if (a.devpathPrefix.size() != b.devpathPrefix.size())
+            return a.devpathPrefix.size() > b.devpathPrefix.size();
+        return a.line < b.line;
+    });
+
+    ruleCount = rules.size();
+    entries.clear();
+    prefixes.clear();
+
+    // Rules usually share a handful of distinct actions; store each once
+    auto fields = [](const RuleAction& a) {
+        return std::tuple(a.kind, a.assetSet, a.fadeDelayMs, a.fadeSpeed, a.frameDelayMs, a.priority);
+    };
+    std::map<decltype(fields(DEFAULT_ACTION)), uint32_t> distinct{{fields(DEFAULT_ACTION), 0}};
+    actions.assign(1, DEFAULT_ACTION);
+    for (Rule& rule : rules) {
+        auto [it, added] = distinct.emplace(fields(rule.action), static_cast<uint32_t>(actions.size()));
+        if (added) actions.push_back(rule.action);
+        rule.actionIndex = it->second;
+    }
+
+    // Entry 0 is the list every other list finally falls back to: the default action
+    entries.push_back(Entry{});
+
+    // Lists are built from the least specific tier up, so each one can link to its fallback
+    // (match() also relies on this order to pick the most specific hit without branching)
+    const Rule* exactBegin = rules.data();
+    const Rule* anyEnd = rules.data() + rules.size();
+    auto tierEnd = [&](const Rule* from, Tier tier) {
+        return std::find_if(from, anyEnd, [&](const Rule& r) { return r.tier != tier; });
+    };
+    const Rule* vendorBegin = tierEnd(exactBegin, Tier::Exact);
+    const Rule* anyBegin = tierEnd(vendorBegin, Tier::Vendor);
+    auto keyEnd = [](const Rule* from, const Rule* end) {
+        return std::find_if(from, end, [&](const Rule& r) { return r.key != from->key; });
+    };
+
+    anyFirst = anyBegin == anyEnd ? 0 : appendList(anyBegin, anyEnd, 0);
+
+    std::vector<Slot> pairs;
+    for (const Rule* r = vendorBegin; r != anyBegin;) {
+        const Rule* end = keyEnd(r, anyBegin);
+        pairs.push_back(Slot{r->key, appendList(r, end, anyFirst)});
+        r = end;
+    }
+    byVendor.build(pairs);
+
+    pairs.clear();
+    for (const Rule* r = exactBegin; r != vendorBegin;) {
+        const Rule* end = keyEnd(r, vendorBegin);
+        uint32_t vendorFirst = byVendor.find(r->key >> 16);
+        pairs.push_back(Slot{r->key, appendList(r, end, vendorFirst != EMPTY ? vendorFirst : anyFirst)});
+        r = end;
+    }
+    exact.build(pairs);
+}
+
+uint32_t RuleEngine::appendList(const Rule* begin, const Rule* end, uint32_t next) {
+    uint32_t first = static_cast<uint32_t>(entries.size());
+    for (const Rule* r = begin; r != end; r++) {
+        Entry entry;
+        entry.target = r->actionIndex;
+
+        // A rule without prefix always matches: whatever follows it is unreachable
+        if (r->devpathPrefix.empty()) {
+            entries.push_back(entry);
+            return first;
+        }
+        entry.prefix = static_cast<uint32_t>(prefixes.size());
+        prefixes += r->devpathPrefix;
+        entry.prefixLength = static_cast<uint32_t>(r->devpathPrefix.size());
+        entries.push_back(entry);
+    }
+
+    // Fall through to the next tier; a list that starts unconditional is copied instead of linked
+    Entry tail = entries[next];
+    if (tail.prefixLength != 0) tail = Entry{0, 0, next | LINK};
+    entries.push_back(tail);
+    return first;
+}
+
+void RuleEngine::Table::build(const std::vector<Slot>& pairs) {
+    // Start at most half full; double until every key fits in the window of its hash
+    size_t size = 8;
+    while (size < pairs.size() * 2) size <<= 1;
+    for (;; size <<= 1) {
+        mask = static_cast<uint32_t>(size - 1);
+        slots.assign(size + WINDOW, Slot{});
+        bool fits = true;
+        for (const Slot& pair : pairs) {
+            Slot* window = &slots[hashKey(pair.key) & mask];
+            Slot* free = std::find_if(window, window + WINDOW, [](const Slot& s) { return s.first == EMPTY; });
+            if (free == window + WINDOW) {
+                fits = false;
+                break;
+            }
+            *free = pair;
+        }
+        if (fits) return;
+    }
+}
+
+inline uint32_t RuleEngine::Table::find(uint32_t key) const {
+    // Every slot of the window is masked in: a hit clears the bits EMPTY has and its list lacks
+    const Slot* window = &slots[hashKey(key) & mask];
+    uint32_t first = EMPTY;
+    for (uint32_t i = 0; i < WINDOW; i++)
+        first &= window[i].first | (static_cast<uint32_t>(window[i].key == key) - 1);
+    return first;
+}
+
+const RuleAction& RuleEngine::resolve(uint32_t first, const char* devpath) const {
+    for (uint32_t i = first;;) {
+        const Entry& entry = entries[i];
+        if (entry.prefixLength == 0) {
+            if (!(entry.target & LINK)) return actions[entry.target];
+            i = entry.target & ~LINK;
+        } else if (strncmp(devpath, prefixes.data() + entry.prefix, entry.prefixLength) == 0) {
+            return actions[entry.target];
+        } else {
+            i++;
+        }
+    }
+}
+
+const RuleAction& RuleEngine::match(uint32_t id, const char* devpath) const {
+    // Two independent probes: the lists already fall back to the vendor and *:* rules.
+    // Exact lists come after vendor lists, which come after the *:* list (see compile()),
+    // so the most specific hit is the largest index once EMPTY wraps to 0.
+    uint32_t first = std::max({exact.find(id) + 1, byVendor.find(id >> 16) + 1, anyFirst + 1}) - 1;
+
+    // Most lists are a single unconditional entry
+    const Entry& entry = entries[first];
+    if (entry.prefixLength == 0 && !(entry.target & LINK)) return actions[entry.target];
+    return resolve(first, devpath);
+}
+
+const RuleAction& RuleEngine::match(const UsbEvent& event) const {
+    return match(pack(event.vendor, event.product), event.devpath);
+}
@@ -0,0 +1,75 @@
+#include "../include/RuntimeConfig.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    // Trims spaces and tabs on both sides.
+    std::string trim(const std::string& text) {
+        size_t begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) return "";
+        size_t end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    // Parses an integer within [min, max].
+    bool parseInt(const std::string& text, int min, int max, int& out) {
+        try {
+            size_t used = 0;
+            int value = std::stoi(text, &used);
+            if (used != text.size() || value < min || value > max) return false;
+            out = value;
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+}
+
+std::unique_ptr<RuntimeConfig> RuntimeConfig::load(const std::string& configPath,
+                                                   const std::string& rulesPath) {
+    auto config = std::make_unique<RuntimeConfig>();
+    if (std::ifstream in(configPath); in) {
+        config->parse(in, configPath);
+    } else if (fs::exists(configPath)) {
+        std::cerr << "⚠️ Could not read config file: " << configPath << "\n";
+    }
+    config->rules.load(rulesPath);
+    return config;
+}
+
+void RuntimeConfig::parse(std::istream& in, const std::string& origin) {
+    std::string line;
+    for (int number = 1; std::getline(in, line); number++) {
+        line.erase(std::find(line.begin(), line.end(), '#'), line.end());
+        line = trim(line);
+        if (line.empty()) continue;
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            std::cerr << "⚠️ " << origin << ":" << number << ": expected key = value\n";
+            continue;
+        }
+        std::string key = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+
+        bool ok = true;
+        if (key == "volume") ok = parseInt(value, 0, 100, volumePercent);
+        else if (key == "fade_delay_ms") ok = parseInt(value, 0, 60000, fadeDelayMs);
+        else if (key == "fade_speed") ok = parseInt(value, 1, 255, fadeSpeed);
+        else if (key == "frame_delay_ms") ok = parseInt(value, 1, 1000, frameDelayMs);
+        else if (key == "audio_buffer") ok = parseInt(value, 64, 8192, audioBufferSamples);
+        else if (key == "voices") ok = parseInt(value, 1, 32, voices);
+        else if (key == "idle_release_s") ok = parseInt(value, 0, 86400, idleReleaseSec);
+        else if (key == "background") assets.background = value;
+        else if (key == "sound") assets.sound = value;
+        else {
+            std::cerr << "⚠️ " << origin << ":" << number << ": unknown key '" << key << "'\n";
+            continue;
+        }
+
+        if (!ok) std::cerr << "⚠️ " << origin << ":" << number << ": invalid " << key
+                           << " '" << value << "', keeping the default\n";
+    }
+}
+
@@ -0,0 +1,42 @@
+#include "../include/SleepWatcher.hpp"
+#include <systemd/sd-bus.h>
+#include <sys/epoll.h>
+#include <cstring>
+#include <iostream>
+
+SleepWatcher::~SleepWatcher() {
+    if (slot) sd_bus_slot_unref(slot);
+    if (bus) sd_bus_flush_close_unref(bus);
+}
+
+bool SleepWatcher::start(EventLoop& loop, Handler handler) {
+    onSleep = std::move(handler);
+
+    int r = sd_bus_open_system(&bus);
+    if (r < 0) {
+        std::cerr << "⚠️ System bus unavailable, resume is not watched: " << strerror(-r) << "\n";
+        bus = nullptr;
+        return false;
+    }
+
+    r = sd_bus_match_signal(bus, &slot, "org.freedesktop.login1", "/org/freedesktop/login1",
+                            "org.freedesktop.login1.Manager", "PrepareForSleep", prepareForSleep, this);
+    if (r < 0) {
+        std::cerr << "⚠️ Could not subscribe to logind sleep signals: " << strerror(-r) << "\n";
+        return false;
+    }
+
+    // Dispatch everything sd-bus has buffered whenever the socket is readable
+    return loop.watch(sd_bus_get_fd(bus), EPOLLIN, [this](uint32_t) {
+        while (sd_bus_process(bus, nullptr) > 0) {}
+    });
+}
+
+int SleepWatcher::prepareForSleep(sd_bus_message* message, void* self, sd_bus_error*) {
+    int sleeping = 0;
+    if (sd_bus_message_read(message, "b", &sleeping) < 0) return 0;
+
+    std::cout << (sleeping ? "💤 System going to sleep\n" : "⏰ System resumed\n");
+    static_cast<SleepWatcher*>(self)->onSleep(sleeping != 0);
+    return 0;
+}
@@ -1,32 +1,56 @@
 #include "SoundGenerator.hpp"
+#include "PulseClient.hpp"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 #include <iostream>
-#include <thread>
-#include <chrono>
 #include <cstdlib>
-#include <sstream>
-#include <filesystem>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
 
-namespace fs = std::filesystem;
+namespace {
+    // Channels are reported as bits of one 32-bit mask
+    constexpr int MAX_VOICES = 32;
 
-SoundGenerator::SoundGenerator(const std::string& name)
-    : appName(name) {}
+    // How long the worker waits for our stream to show up before muting nothing
+    constexpr std::chrono::milliseconds STREAM_TIMEOUT{500};
+}
+
+std::atomic<SoundGenerator*> SoundGenerator::callbackTarget{nullptr};
+
+SoundGenerator::SoundGenerator(const std::string& name, std::unique_ptr<StreamControl> control)
+    : appName(name), streams(control ? std::move(control) : std::make_unique<PulseClient>()) {
+    finishedFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (finishedFd < 0) {
+        std::cerr << "❌ eventfd creation failed: " << strerror(errno) << "\n";
+    }
+}
 
 SoundGenerator::~SoundGenerator() {
     cleanup();
+    if (finishedFd >= 0) close(finishedFd);
 }
 
-bool SoundGenerator::init() {
+void SoundGenerator::prepareEnvironment() {
+    if (environmentReady) return;
+
     // Ensure PulseAudio environment variables exist (important for daemons)
     if (!getenv("PULSE_SERVER")) setenv("PULSE_SERVER", ("unix:/run/user/" + std::to_string(getuid()) + "/pulse/native").c_str(), 1);
     if (!getenv("XDG_RUNTIME_DIR")) setenv("XDG_RUNTIME_DIR", ("/run/user/" + std::to_string(getuid())).c_str(), 1);
 
-    // Identify application in PulseAudio and force Pulse as SDL audio driver
+    // Identify application in PulseAudio and use Pulse as SDL audio driver,
+    // unless one was chosen explicitly (benchmarks run on the dummy driver)
     setenv("PULSE_PROP_application.name", appName.c_str(), 1);
     setenv("PULSE_PROP_media.role", "alert", 1);
-    setenv("SDL_AUDIODRIVER", "pulse", 1);
+    setenv("SDL_AUDIODRIVER", "pulse", 0);
+    environmentReady = true;
+}
+
+bool SoundGenerator::init(int bufferSamples, int voiceCount) {
+    if (audioReady) return true;
+    prepareEnvironment();
 
     // Initialize SDL audio subsystem
     if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
@@ -34,83 +58,201 @@ bool SoundGenerator::init() {
         return false;
     }
 
-    // Open audio stream through SDL_mixer
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+    // Enable MP3 decoding so alerts can be decoded into chunks
+    Mix_Init(MIX_INIT_MP3);
+
+    // Open audio stream through SDL_mixer; it stays open for the daemon's lifetime.
+    // A small buffer keeps output latency low (the alert is pre-decoded, so no underruns from decoding)
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, bufferSamples) < 0) {
         std::cerr << "❌ SDL_mixer init failed: " << Mix_GetError() << "\n";
         SDL_QuitSubSystem(SDL_INIT_AUDIO);
         return false;
     }
 
+    // Fixed voice pool: overlapping alerts mix on separate channels
+    int allocated = Mix_AllocateChannels(std::clamp(voiceCount, 1, MAX_VOICES));
+    voices.assign(allocated, Voice{});
+    activeVoices = 0;
+    finishedChannels = 0;
+    std::cout << "🔊 Audio open: " << bufferSamples << "-frame buffer, " << allocated << " voices\n";
+
+    // Completion is pushed to us by the mixer instead of polled
+    callbackTarget = this;
+    Mix_ChannelFinished(channelFinished);
+
+    // Connect the stream controller; alerts still play without it
+    if (!streams->connect()) {
+        std::cerr << "⚠️ PulseAudio control unavailable, other streams will not be muted.\n";
+    }
+
+    stopping = false;
+    worker = std::thread([this]() { runJobs(); });
+
     audioReady = true;
     return true;
 }
 
-int SoundGenerator::getLatestSinkInputId() {
-    // Query PulseAudio for the most recent audio stream ID
-    FILE* pipe = popen("pactl list short sink-inputs | awk '{print $1}' | tail -n 1", "r");
-    if (!pipe) return -1;
+void SoundGenerator::channelFinished(int channel) {
+    SoundGenerator* self = callbackTarget.load();
+    if (!self || channel < 0 || channel >= MAX_VOICES) return;
 
-    char buffer[16];
-    std::string result;
-    while (fgets(buffer, sizeof(buffer), pipe)) result += buffer;
-    pclose(pipe);
+    // Audio thread: no locks, no SDL_mixer calls, just flag and wake.
+    // A failed write means the counter is already pending, which wakes the loop anyway.
+    self->finishedChannels.fetch_or(1u << channel);
+    uint64_t one = 1;
+    ssize_t written = write(self->finishedFd, &one, sizeof(one));
+    (void)written;
+}
 
-    try {
-        return std::stoi(result);
-    } catch (...) {
-        return -1;
-    }
+void SoundGenerator::firstBuffer(int, void*, int, void* self) {
+    // Called for every buffer of the channel; only the first one after play() costs more than a load
+    SoundGenerator* generator = static_cast<SoundGenerator*>(self);
+    if (!generator->firstBufferPending.load(std::memory_order_relaxed) ||
+        !generator->firstBufferPending.exchange(false))
+        return;
+
+    generator->firstBufferNs.store(std::chrono::steady_clock::now().time_since_epoch().count());
+    uint64_t one = 1;
+    ssize_t written = write(generator->finishedFd, &one, sizeof(one));
+    (void)written;
 }
 
-void SoundGenerator::muteAllExcept(int keepId) {
-    // Mute all other audio streams except our alert
-    std::ostringstream cmd;
-    cmd << "for id in $(pactl list short sink-inputs | awk '{print $1}'); do "
-        << "if [ \"$id\" != \"" << keepId << "\" ]; then "
-        << "pactl set-sink-input-mute $id 1; fi; done";
-    system(cmd.str().c_str());
+bool SoundGenerator::takeFirstBuffer(std::chrono::steady_clock::time_point& at) {
+    int64_t ns = firstBufferNs.exchange(0);
+    if (ns == 0) return false;
+    at = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(ns));
+    return true;
 }
 
-void SoundGenerator::restoreAll() {
-    // Restore sound to all streams
-    system("for id in $(pactl list short sink-inputs | awk '{print $1}'); do "
-           "pactl set-sink-input-mute $id 0; done");
+int SoundGenerator::pickVoice(int priority) const {
+    int victim = -1;
+    for (int channel = 0; channel < static_cast<int>(voices.size()); channel++) {
+        if (!Mix_Playing(channel)) return channel;
+
+        // Lowest priority first, then the oldest voice
+        const Voice& voice = voices[channel];
+        if (victim < 0 || voice.priority < voices[victim].priority ||
+            (voice.priority == voices[victim].priority && voice.startedAt < voices[victim].startedAt))
+            victim = channel;
+    }
+    if (victim >= 0 && voices[victim].priority > priority) return -1;
+    return victim;
 }
 
-void SoundGenerator::play(const std::string& soundPath, int volumePercent) {
-    if (!audioReady) return;
+bool SoundGenerator::play(Mix_Chunk* chunk, int volumePercent, int priority) {
+    if (!audioReady || !chunk) return false;
+
+    int channel = pickVoice(priority);
+    if (channel < 0) {
+        std::cout << "🔇 All voices busy with higher-priority alerts, skipping sound\n";
+        return false;
+    }
+
+    // A stolen voice is cut; it stays counted as active for its successor
+    if (Mix_Playing(channel)) {
+        std::cout << "🔁 Stealing voice " << channel << " (priority " << voices[channel].priority << ")\n";
+        Mix_HaltChannel(channel);
+    }
 
-    // Set global system volume to desired level
-    std::string volCmd = "pactl set-sink-volume @DEFAULT_SINK@ " +
-                         std::to_string(volumePercent) + "% 2>/dev/null";
-    system(volCmd.c_str());
+    Voice& voice = voices[channel];
+    // Loudness is normalized at load time; the volume only scales this voice, never the system sink
+    Mix_Volume(channel, std::clamp(volumePercent, 0, 100) * MIX_MAX_VOLUME / 100);
 
-    Mix_Music* music = Mix_LoadMUS(soundPath.c_str());
-    if (!music) {
-        std::cerr << "⚠️ Could not load sound: " << soundPath << " | " << Mix_GetError() << "\n";
-        return;
+    // Hooked before the channel starts so the first buffer cannot slip by; the mixer drops it when the channel ends
+    firstBufferNs = 0;
+    firstBufferPending = true;
+    Mix_RegisterEffect(channel, firstBuffer, nullptr, this);
+    if (Mix_PlayChannel(channel, chunk, 0) < 0) {
+        std::cerr << "⚠️ Could not play sound: " << Mix_GetError() << "\n";
+        Mix_UnregisterAllEffects(channel);
+        firstBufferPending = false;
+        return false;
     }
+    voice.priority = priority;
+    voice.startedAt = std::chrono::steady_clock::now();
+
+    bool firstVoice = false;
+    if (!voice.active) {
+        voice.active = true;
+        firstVoice = activeVoices++ == 0;
+    }
+
+    // Mute the others as soon as the server announces our stream
+    if (firstVoice) {
+        post([this]() {
+            int64_t myId = streams->awaitStream(appName, STREAM_TIMEOUT);
+            if (myId != -1) streams->muteAllExcept(static_cast<uint32_t>(myId));
+            else std::cerr << "⚠️ Alert stream not seen by PulseAudio, other streams stay audible\n";
+        });
+    }
+    return true;
+}
 
-    // Start playing music once
-    Mix_PlayMusic(music, 0);
+void SoundGenerator::onChannelsFinished() {
+    uint64_t pending = 0;
+    if (read(finishedFd, &pending, sizeof(pending)) < 0 && errno != EAGAIN) return;
 
-    // Wait for PulseAudio to register the new stream before muting others
-    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    uint32_t finished = finishedChannels.exchange(0);
+    for (int channel = 0; finished && channel < static_cast<int>(voices.size()); channel++) {
+        if (!(finished & (1u << channel))) continue;
 
-    int myId = getLatestSinkInputId();
-    if (myId != -1) muteAllExcept(myId);
+        // A halted voice that was immediately reused is still playing
+        Voice& voice = voices[channel];
+        if (!voice.active || Mix_Playing(channel)) continue;
+        voice.active = false;
+        activeVoices--;
+    }
 
-    // Wait until playback finishes
-    while (Mix_PlayingMusic()) SDL_Delay(50);
+    // The last voice to end gives the other streams their sound back
+    if (audioReady && activeVoices == 0 && finished) {
+        post([this]() { streams->restoreAll(); });
+    }
+}
 
-    Mix_FreeMusic(music);
-    restoreAll();
+void SoundGenerator::post(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobs.push_back(std::move(job));
+    }
+    jobReady.notify_one();
+}
+
+void SoundGenerator::runJobs() {
+    std::unique_lock<std::mutex> lock(jobMutex);
+    while (true) {
+        jobReady.wait(lock, [this]() { return stopping || !jobs.empty(); });
+        if (jobs.empty()) return;
+
+        std::function<void()> job = std::move(jobs.front());
+        jobs.pop_front();
+        lock.unlock();
+        job();
+        lock.lock();
+    }
 }
 
 void SoundGenerator::cleanup() {
     if (audioReady) {
-        Mix_HaltMusic();
+        // Stop completion callbacks before halting, so none races our teardown
+        Mix_ChannelFinished(nullptr);
+        callbackTarget = nullptr;
+        Mix_HaltChannel(-1);
+
+        // Never leave other applications muted behind us; the worker drains its queue first
+        post([this]() { streams->restoreAll(); });
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            stopping = true;
+        }
+        jobReady.notify_one();
+        if (worker.joinable()) worker.join();
+        streams->disconnect();
+
         Mix_CloseAudio();
+        voices.clear();
+        activeVoices = 0;
+        finishedChannels = 0;
+        Mix_Quit();
         SDL_QuitSubSystem(SDL_INIT_AUDIO);
         audioReady = false;
     }
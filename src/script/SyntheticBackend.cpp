@@ -0,0 +1,125 @@
+#include "../include/SyntheticBackend.hpp"
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // Flood mode: tick as fast as the timer allows and let catch-up size the bursts
+    constexpr long FLOOD_PERIOD_NS = 1000;
+
+    timespec toTimespec(int64_t ns) {
+        return timespec{static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000)};
+    }
+}
+
+bool SyntheticProfile::parseMix(std::string_view text, std::vector<SyntheticDevice>& out) {
+    std::vector<SyntheticDevice> mix;
+    while (!text.empty()) {
+        size_t comma = text.find(',');
+        std::string_view entry = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+
+        SyntheticDevice device;
+        size_t star = entry.find('*');
+        if (star != std::string_view::npos) {
+            uint16_t weight = UsbEvent::parseDecimal(entry.substr(star + 1));
+            if (weight == 0) return false;
+            device.weight = weight;
+            entry = entry.substr(0, star);
+        }
+        size_t colon = entry.find(':');
+        if (colon == std::string_view::npos || !UsbEvent::parseHex(entry.substr(0, colon), device.vendor) ||
+            !UsbEvent::parseHex(entry.substr(colon + 1), device.product))
+            return false;
+        mix.push_back(device);
+    }
+    if (mix.empty()) return false;
+    out = std::move(mix);
+    return true;
+}
+
+SyntheticBackend::SyntheticBackend(SyntheticProfile shape)
+    : profile(std::move(shape)), state(profile.seed ? profile.seed : 1) {
+    if (profile.mix.empty()) profile.mix.push_back(SyntheticDevice{0x046d, 0xc534, 1});
+    profile.burstSize = std::max(profile.burstSize, 1u);
+
+    unsigned total = 0;
+    for (const SyntheticDevice& device : profile.mix) cumulative.push_back(total += device.weight);
+
+    timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer < 0) {
+        std::cerr << "❌ timerfd creation failed: " << strerror(errno) << "\n";
+    }
+}
+
+SyntheticBackend::~SyntheticBackend() {
+    if (timer >= 0) close(timer);
+}
+
+void SyntheticBackend::start() {
+    if (timer < 0 || profile.totalEvents == 0) {
+        done.store(true, std::memory_order_release);
+        return;
+    }
+
+    int64_t period = profile.eventsPerSec > 0
+        ? static_cast<int64_t>(1e9 * profile.burstSize / profile.eventsPerSec)
+        : FLOOD_PERIOD_NS;
+    period = std::max<int64_t>(period, FLOOD_PERIOD_NS);
+
+    // The first burst goes out right away, the next ones on the period
+    itimerspec spec{toTimespec(period), toTimespec(1)};
+    startedAt = std::chrono::steady_clock::now();
+    timerfd_settime(timer, 0, &spec, nullptr);
+}
+
+void SyntheticBackend::receive(const Callback& onEvent) {
+    uint64_t ticks = 0;
+    if (read(timer, &ticks, sizeof(ticks)) < 0) return;
+
+    uint64_t next = count.load(std::memory_order_relaxed);
+    uint64_t due = std::min(ticks * profile.burstSize, profile.totalEvents - next);
+    UsbEvent event;
+    for (uint64_t i = 0; i < due; i++) {
+        generate(next + i, event);
+        onEvent(event);
+    }
+    count.store(next + due, std::memory_order_relaxed);
+    elapsedNs.store((std::chrono::steady_clock::now() - startedAt).count(), std::memory_order_relaxed);
+
+    if (next + due >= profile.totalEvents) {
+        itimerspec off{};
+        timerfd_settime(timer, 0, &off, nullptr);
+        done.store(true, std::memory_order_release);
+    }
+}
+
+void SyntheticBackend::generate(uint64_t index, UsbEvent& event) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    unsigned pick = static_cast<unsigned>(state % cumulative.back());
+    const SyntheticDevice& device =
+        profile.mix[std::upper_bound(cumulative.begin(), cumulative.end(), pick) - cumulative.begin()];
+
+    // A distinct port path per event, like a stream of different devices
+    event = UsbEvent{};
+    event.stamp();
+    event.action = UsbAction::Add;
+    event.seqnum = index + 1;
+    event.vendor = device.vendor;
+    event.product = device.product;
+    event.busnum = static_cast<uint16_t>(1 + index / 127 % 16);
+    event.devnum = static_cast<uint16_t>(1 + index % 127);
+
+    char text[UsbEvent::DEVPATH_CAPACITY];
+    int len = snprintf(text, sizeof(text), "/dev/bus/usb/%03u/%03u", event.busnum, event.devnum);
+    if (len > 0) event.setDevnode(std::string_view(text, std::min<size_t>(len, sizeof(text) - 1)));
+    len = snprintf(text, sizeof(text), "/devices/synthetic/usb%u/%u-%llu", event.busnum, event.busnum,
+                   static_cast<unsigned long long>(index));
+    if (len > 0) event.setDevpath(std::string_view(text, std::min<size_t>(len, sizeof(text) - 1)));
+}
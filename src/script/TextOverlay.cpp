@@ -0,0 +1,215 @@
+#include "../include/TextOverlay.hpp"
+#include "../include/GlyphFont.hpp"
+#include "../include/Config.hpp"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "TextOverlay needs SDL 2.0.18 or later (SDL_RenderGeometry)"
+#endif
+
+namespace {
+    // 16 x 6 cells: the 95 printable glyphs, then one solid cell for the backdrop
+    constexpr int ATLAS_COLUMNS = 16;
+    constexpr int ATLAS_ROWS = 6;
+    constexpr int ATLAS_WIDTH = ATLAS_COLUMNS * GlyphFont::WIDTH;
+    constexpr int ATLAS_HEIGHT = ATLAS_ROWS * GlyphFont::HEIGHT;
+    constexpr int SOLID_CELL = GlyphFont::COUNT;
+    static_assert(SOLID_CELL < ATLAS_COLUMNS * ATLAS_ROWS, "atlas too small for the font");
+
+    SDL_Texture* buildAtlas(SDL_Renderer* renderer) {
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, ATLAS_HEIGHT, 32, SDL_PIXELFORMAT_RGBA32);
+        if (!surface) return nullptr;
+
+        // White pixels; the glyph bits only decide the alpha, the vertex colors tint them
+        auto* pixels = static_cast<uint8_t*>(surface->pixels);
+        std::memset(pixels, 0, static_cast<size_t>(surface->pitch) * ATLAS_HEIGHT);
+        for (int cell = 0; cell <= SOLID_CELL; cell++) {
+            int x0 = (cell % ATLAS_COLUMNS) * GlyphFont::WIDTH;
+            int y0 = (cell / ATLAS_COLUMNS) * GlyphFont::HEIGHT;
+            for (int y = 0; y < GlyphFont::HEIGHT; y++) {
+                uint8_t bits = cell == SOLID_CELL ? 0xFF : GlyphFont::ROWS[cell][y];
+                uint8_t* row = pixels + static_cast<size_t>(y0 + y) * surface->pitch + 4 * x0;
+                for (int x = 0; x < GlyphFont::WIDTH; x++) {
+                    row[4 * x + 0] = row[4 * x + 1] = row[4 * x + 2] = 255;
+                    row[4 * x + 3] = (bits & (0x80 >> x)) ? 255 : 0;
+                }
+            }
+        }
+
+        SDL_Texture* atlas = SDL_CreateTextureFromSurface(renderer, surface);
+        SDL_FreeSurface(surface);
+        if (!atlas) return nullptr;
+        SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(atlas, SDL_ScaleModeNearest);
+        return atlas;
+    }
+
+    // Vertices of a quad in top-left, top-right, bottom-left, bottom-right order
+    void setQuad(SDL_Vertex* v, float x0, float y0, float x1, float y1,
+                 float u0, float v0, float u1, float v1, SDL_Color color) {
+        v[0] = {{x0, y0}, color, {u0, v0}};
+        v[1] = {{x1, y0}, color, {u1, v0}};
+        v[2] = {{x0, y1}, color, {u0, v1}};
+        v[3] = {{x1, y1}, color, {u1, v1}};
+    }
+
+    // Lines of `text`, ignoring a trailing newline
+    size_t countLines(const char* text) {
+        size_t lines = 1;
+        for (const char* p = text; *p; p++) {
+            if (*p == '\n' && p[1]) lines++;
+        }
+        return lines;
+    }
+}
+
+struct TextOverlay::Target {
+    SDL_Renderer* renderer = nullptr;  ///< Renderer the atlas belongs to.
+    SDL_Texture* atlas = nullptr;      ///< Glyph atlas with a solid cell.
+    std::vector<SDL_Vertex> vertices;  ///< Four per quad, backdrop first.
+    int width = 0;                     ///< Output width in pixels.
+    int height = 0;                    ///< Output height in pixels.
+    size_t quads = 0;                  ///< Quads laid out, backdrop included.
+    int alpha = -1;                    ///< Opacity the vertices carry now.
+};
+
+TextOverlay::TextOverlay() = default;
+
+TextOverlay::~TextOverlay() {
+    release();
+}
+
+bool TextOverlay::load(const std::vector<SDL_Renderer*>& renderers) {
+    release();
+    if (!DisplayConfig::SHOW_EVENT_DETAILS) return false;
+
+    // Buffers are sized once here; nothing grows afterwards
+    constexpr size_t QUADS = MAX_GLYPHS + 1;
+    indices.resize(QUADS * 6);
+    for (size_t quad = 0; quad < QUADS; quad++) {
+        int base = static_cast<int>(quad * 4);
+        int* out = &indices[quad * 6];
+        out[0] = base; out[1] = base + 1; out[2] = base + 2;
+        out[3] = base + 2; out[4] = base + 1; out[5] = base + 3;
+    }
+
+    bool any = false;
+    targets.resize(renderers.size());
+    for (size_t i = 0; i < renderers.size(); i++) {
+        Target& target = targets[i];
+        target.renderer = renderers[i];
+        if (!target.renderer || SDL_GetRendererOutputSize(target.renderer, &target.width, &target.height) < 0) continue;
+        target.atlas = buildAtlas(target.renderer);
+        if (!target.atlas) {
+            std::cerr << "⚠️ Glyph atlas unavailable on screen " << i << ": " << SDL_GetError() << "\n";
+            continue;
+        }
+        target.vertices.resize(QUADS * 4);
+        any = true;
+    }
+    return any;
+}
+
+void TextOverlay::release() {
+    for (Target& target : targets) {
+        if (target.atlas) SDL_DestroyTexture(target.atlas);
+    }
+    targets.clear();
+    indices.clear();
+}
+
+void TextOverlay::layout(const char* text) {
+    for (Target& target : targets) layoutTarget(target, text ? text : "");
+}
+
+void TextOverlay::layoutTarget(Target& target, const char* text) {
+    target.quads = 0;
+    target.alpha = -1;
+    if (!target.atlas || !*text) return;
+
+    // Integer scale keeps the bitmap sharp; the box sits one line above the bottom-left corner
+    int scale = std::max(1, target.height / (DisplayConfig::TEXT_ROWS * GlyphFont::HEIGHT));
+    int glyphW = GlyphFont::WIDTH * scale;
+    int glyphH = GlyphFont::HEIGHT * scale;
+    int pad = glyphH / 2;
+    int margin = glyphH;
+    size_t maxColumns = static_cast<size_t>(std::max(1, (target.width - 2 * margin - 2 * pad) / glyphW));
+    size_t maxLines = static_cast<size_t>(std::max(1, (target.height - 2 * margin - 2 * pad) / glyphH));
+
+    // Too many lines: keep the first ones and say how many were left out
+    size_t lines = countLines(text);
+    size_t shown = lines <= maxLines ? lines : maxLines - 1;
+    char more[32] = {};
+    if (shown < lines) std::snprintf(more, sizeof(more), "+%zu more", lines - shown);
+
+    // Box size first: the longest visible line, cut to the screen
+    size_t columns = std::min(std::strlen(more), maxColumns);
+    const char* p = text;
+    for (size_t line = 0; line < shown; line++) {
+        const char* end = std::strchr(p, '\n');
+        size_t length = end ? static_cast<size_t>(end - p) : std::strlen(p);
+        columns = std::max(columns, std::min(length, maxColumns));
+        p = end ? end + 1 : p + length;
+    }
+    size_t rows = shown + (more[0] ? 1 : 0);
+    float boxW = static_cast<float>(columns * glyphW + 2 * pad);
+    float boxH = static_cast<float>(rows * glyphH + 2 * pad);
+    float left = static_cast<float>(margin);
+    float top = static_cast<float>(target.height - margin) - boxH;
+
+    const float cellU = static_cast<float>(GlyphFont::WIDTH) / ATLAS_WIDTH;
+    const float cellV = static_cast<float>(GlyphFont::HEIGHT) / ATLAS_HEIGHT;
+    const SDL_Color black{0, 0, 0, 0};
+    const SDL_Color white{255, 255, 255, 0};
+
+    // Backdrop: the centre of the solid cell stretched over the box
+    float solidU = ((SOLID_CELL % ATLAS_COLUMNS) + 0.5f) * cellU;
+    float solidV = ((SOLID_CELL / ATLAS_COLUMNS) + 0.5f) * cellV;
+    setQuad(&target.vertices[0], left, top, left + boxW, top + boxH, solidU, solidV, solidU, solidV, black);
+    target.quads = 1;
+
+    auto emitLine = [&](const char* line, size_t length, size_t row) {
+        float y = top + static_cast<float>(pad + row * glyphH);
+        for (size_t col = 0; col < std::min(length, maxColumns) && target.quads <= MAX_GLYPHS; col++) {
+            char c = line[col];
+            if (c == ' ') continue;
+            if (c < GlyphFont::FIRST || c > GlyphFont::LAST) c = '?';
+            int cell = c - GlyphFont::FIRST;
+            float u = static_cast<float>(cell % ATLAS_COLUMNS) * cellU;
+            float v = static_cast<float>(cell / ATLAS_COLUMNS) * cellV;
+            float x = left + static_cast<float>(pad + col * glyphW);
+            setQuad(&target.vertices[target.quads * 4], x, y, x + glyphW, y + glyphH,
+                    u, v, u + cellU, v + cellV, white);
+            target.quads++;
+        }
+    };
+
+    p = text;
+    for (size_t line = 0; line < shown; line++) {
+        const char* end = std::strchr(p, '\n');
+        size_t length = end ? static_cast<size_t>(end - p) : std::strlen(p);
+        emitLine(p, length, line);
+        p = end ? end + 1 : p + length;
+    }
+    if (more[0]) emitLine(more, std::strlen(more), shown);
+}
+
+void TextOverlay::draw(size_t screen, uint8_t alpha) {
+    if (screen >= targets.size()) return;
+    Target& target = targets[screen];
+    if (!target.atlas || target.quads == 0) return;
+
+    // The fade only changes opacity: rewrite the alpha bytes, nothing else
+    if (target.alpha != alpha) {
+        uint8_t backdrop = static_cast<uint8_t>(alpha * DisplayConfig::TEXT_BACKDROP_ALPHA / 255);
+        for (size_t i = 0; i < 4; i++) target.vertices[i].color.a = backdrop;
+        for (size_t i = 4; i < target.quads * 4; i++) target.vertices[i].color.a = alpha;
+        target.alpha = alpha;
+    }
+    SDL_RenderGeometry(target.renderer, target.atlas, target.vertices.data(), static_cast<int>(target.quads * 4),
+                       indices.data(), static_cast<int>(target.quads * 6));
+}
@@ -0,0 +1,97 @@
+#include "../include/UdevBackend.hpp"
+#include "../include/Config.hpp"
+#include <libudev.h>
+
+UdevBackend::UdevBackend() {
+    // Initialize udev context and setup USB device monitoring.
+    udev = udev_new();
+    mon = udev_monitor_new_from_netlink(udev, "udev");
+    udev_monitor_filter_add_match_subsystem_devtype(mon, "usb", "usb_device");
+    udev_monitor_set_receive_buffer_size(mon, MonitorConfig::RECEIVE_BUFFER_BYTES);
+    udev_monitor_enable_receiving(mon);
+}
+
+UdevBackend::~UdevBackend() {
+    // Clean up resources allocated by libudev.
+    udev_monitor_unref(mon);
+    udev_unref(udev);
+}
+
+int UdevBackend::fd() const {
+    return mon ? udev_monitor_get_fd(mon) : -1;
+}
+
+namespace {
+    // Properties come with the message (or the device's uevent file); sysattrs would read sysfs once each
+    void fillEvent(struct udev_device* dev, UsbAction action, UsbEvent& event) {
+        event.stamp();
+        event.action = action;
+        if (const char* ids = udev_device_get_property_value(dev, "PRODUCT"))
+            event.setIds(ids);
+        if (const char* bus = udev_device_get_property_value(dev, "BUSNUM"))
+            event.busnum = UsbEvent::parseDecimal(bus);
+        if (const char* num = udev_device_get_property_value(dev, "DEVNUM"))
+            event.devnum = UsbEvent::parseDecimal(num);
+        if (const char* devnode = udev_device_get_devnode(dev))
+            event.setDevnode(devnode);
+        if (const char* devpath = udev_device_get_devpath(dev))
+            event.setDevpath(devpath);
+    }
+}
+
+void UdevBackend::receive(const Callback& onEvent) {
+    // Drain every pending device; the socket is non-blocking.
+    while (struct udev_device* dev = udev_monitor_receive_device(mon)) {
+        const char* action = udev_device_get_action(dev);
+
+        // Every action is reported; `UsbMonitor` journals them and alerts on "add" only.
+        if (action) {
+            UsbEvent event;
+            fillEvent(dev, UsbEvent::parseAction(action), event);
+            event.seqnum = udev_device_get_seqnum(dev);
+            // CLOCK_MONOTONIC µs at which udevd first handled the device: the
+            // closest thing to a kernel timestamp, uevents carry none
+            if (const char* usec = udev_device_get_property_value(dev, "USEC_INITIALIZED")) {
+                if (uint64_t at = UsbEvent::parseUnsigned(usec))
+                    event.kernelAt = std::chrono::steady_clock::time_point(std::chrono::microseconds(at));
+            }
+            onEvent(event);
+        }
+
+        udev_device_unref(dev);
+    }
+}
+
+size_t UdevBackend::enumerate(const Callback& onDevice) {
+    return scanDevices(udev, onDevice);
+}
+
+size_t UdevBackend::scanDevices(struct udev* context, const Callback& onDevice) {
+    struct udev* owned = context ? nullptr : udev_new();
+    if (!context) context = owned;
+    if (!context) return 0;
+
+    // The DEVTYPE match skips interfaces and endpoints inside libudev's scan
+    size_t found = 0;
+    struct udev_enumerate* scan = udev_enumerate_new(context);
+    udev_enumerate_add_match_subsystem(scan, "usb");
+    udev_enumerate_add_match_property(scan, "DEVTYPE", "usb_device");
+    udev_enumerate_scan_devices(scan);
+
+    struct udev_list_entry* entry;
+    udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(scan)) {
+        struct udev_device* dev = udev_device_new_from_syspath(context, udev_list_entry_get_name(entry));
+        if (!dev) continue;
+
+        // Already initialized long ago: no kernel time, tracing starts at the scan
+        UsbEvent event;
+        fillEvent(dev, UsbAction::Add, event);
+        onDevice(event);
+        found++;
+        udev_device_unref(dev);
+    }
+
+    udev_enumerate_unref(scan);
+    if (owned) udev_unref(owned);
+    return found;
+}
@@ -1,16 +1,105 @@
 #include "../include/UsbEvent.hpp"
+#include <cstdio>
+#include <cstring>
 
-// Simple value constructor: initializes all fields.
-UsbEvent::UsbEvent(const std::string& action,
-                   const std::string& vendor,
-                   const std::string& product,
-                   const std::string& devnode)
-    : action(action), vendor(vendor), product(product), devnode(devnode) {}
-
-// Returns a human-readable representation of the event.
-std::string UsbEvent::toString() const {
-    return "Action: " + action +
-           "\nVendor: " + vendor +
-           "\nProduct: " + product +
-           "\nNode: " + devnode;
+namespace {
+    // Copies a view into a fixed buffer, truncating and NUL-terminating.
+    void copyInto(char* dst, size_t capacity, std::string_view src) {
+        size_t len = src.size() < capacity - 1 ? src.size() : capacity - 1;
+        memcpy(dst, src.data(), len);
+        dst[len] = '\0';
+    }
+}
+
+void UsbEvent::setDevnode(std::string_view node) {
+    copyInto(devnode, sizeof(devnode), node);
+}
+
+void UsbEvent::setDevpath(std::string_view path) {
+    copyInto(devpath, sizeof(devpath), path);
+}
+
+bool UsbEvent::setIds(std::string_view property) {
+    size_t slash = property.find('/');
+    if (slash == std::string_view::npos) return false;
+    std::string_view rest = property.substr(slash + 1);
+
+    uint16_t vid, pid;
+    if (!parseHex(property.substr(0, slash), vid) || !parseHex(rest.substr(0, rest.find('/')), pid))
+        return false;
+    vendor = vid;
+    product = pid;
+    return true;
+}
+
+// Writes a human-readable representation of the event.
+size_t UsbEvent::format(char* buf, size_t size) const {
+    int len = snprintf(buf, size, "Action: %s\nVendor: %04x\nProduct: %04x\nNode: %s",
+                       actionName(action), vendor, product, devnode[0] ? devnode : "unknown");
+    if (len < 0) return 0;
+    return static_cast<size_t>(len) < size ? static_cast<size_t>(len) : (size ? size - 1 : 0);
+}
+
+void UsbEvent::formatId(char* buf) const {
+    snprintf(buf, ID_TEXT_SIZE, "%04x:%04x", vendor, product);
+}
+
+uint64_t UsbEvent::devpathHash() const {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (const char* p = devpath; *p; p++) hash = (hash ^ static_cast<uint8_t>(*p)) * 0x100000001b3ull;
+    return hash;
+}
+
+UsbAction UsbEvent::parseAction(std::string_view action) {
+    if (action == "add") return UsbAction::Add;
+    if (action == "remove") return UsbAction::Remove;
+    if (action == "change") return UsbAction::Change;
+    if (action == "bind") return UsbAction::Bind;
+    if (action == "unbind") return UsbAction::Unbind;
+    return UsbAction::Unknown;
+}
+
+const char* UsbEvent::actionName(UsbAction action) {
+    switch (action) {
+        case UsbAction::Add: return "add";
+        case UsbAction::Remove: return "remove";
+        case UsbAction::Change: return "change";
+        case UsbAction::Bind: return "bind";
+        case UsbAction::Unbind: return "unbind";
+        default: return "unknown";
+    }
+}
+
+bool UsbEvent::parseHex(std::string_view text, uint16_t& out) {
+    if (text.empty() || text.size() > 4) return false;
+    uint16_t value = 0;
+    for (char c : text) {
+        uint16_t digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return false;
+        value = static_cast<uint16_t>(value << 4 | digit);
+    }
+    out = value;
+    return true;
+}
+
+uint16_t UsbEvent::parseDecimal(std::string_view text) {
+    unsigned value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9' || value > 0xffff) return 0;
+        value = value * 10 + (c - '0');
+    }
+    return value > 0xffff ? 0 : static_cast<uint16_t>(value);
+}
+
+uint64_t UsbEvent::parseUnsigned(std::string_view text) {
+    if (text.empty() || text.size() > 19) return 0;
+    uint64_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return 0;
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return value;
 }
@@ -1,53 +1,125 @@
 #include "../include/UsbMonitor.hpp"
-#include <libudev.h>
+#include "../include/UdevBackend.hpp"
+#include "../include/NetlinkBackend.hpp"
+#include "../include/Config.hpp"
 #include <iostream>
-#include <sys/select.h>
-
-UsbMonitor::UsbMonitor() {
-    // Initialize udev context and setup USB device monitoring.
-    udev = udev_new();
-    mon = udev_monitor_new_from_netlink(udev, "udev");
-    udev_monitor_filter_add_match_subsystem_devtype(mon, "usb", "usb_device");
-    udev_monitor_enable_receiving(mon);
-}
-
-UsbMonitor::~UsbMonitor() {
-    // Clean up resources allocated by libudev.
-    udev_monitor_unref(mon);
-    udev_unref(udev);
-}
-
-void UsbMonitor::startMonitoring(const Callback& onEvent) {
-    // Listen for USB plug/unplug events indefinitely.
-    int fd = udev_monitor_get_fd(mon);
-
-    while (true) {
-        fd_set fds;
-        FD_ZERO(&fds);
-        FD_SET(fd, &fds);
-
-        int ret = select(fd + 1, &fds, NULL, NULL, NULL);
-        if (ret > 0 && FD_ISSET(fd, &fds)) {
-            struct udev_device* dev = udev_monitor_receive_device(mon);
-            if (dev) {
-                const char* action = udev_device_get_action(dev);
-                const char* vendor = udev_device_get_sysattr_value(dev, "idVendor");
-                const char* product = udev_device_get_sysattr_value(dev, "idProduct");
-                const char* devnode = udev_device_get_devnode(dev);
-
-                // Only trigger when a new USB device is added.
-                if (action && std::string(action) == "add") {
-                    UsbEvent event(
-                        action ? action : "unknown",
-                        vendor ? vendor : "unknown",
-                        product ? product : "unknown",
-                        devnode ? devnode : "unknown"
-                    );
-                    onEvent(event);
-                }
-
-                udev_device_unref(dev);
-            }
+#include <vector>
+#include <sys/epoll.h>
+
+namespace {
+    std::unique_ptr<MonitorBackend> makeBackend() {
+        if (MonitorConfig::USE_KERNEL_UEVENTS) return std::make_unique<NetlinkBackend>();
+        return std::make_unique<UdevBackend>();
+    }
+}
+
+UsbMonitor::UsbMonitor() : UsbMonitor(nullptr) {}
+
+UsbMonitor::UsbMonitor(std::unique_ptr<MonitorBackend> backend)
+    : backend(backend ? std::move(backend) : makeBackend()) {}
+
+int UsbMonitor::fd() const {
+    return backend->fd();
+}
+
+const char* UsbMonitor::backendName() const {
+    return backend->name();
+}
+
+bool UsbMonitor::startMonitoring(EventLoop& loop, Callback onEvent) {
+    if (fd() < 0) {
+        std::cerr << "❌ USB monitor (" << backendName() << ") has no event source\n";
+        return false;
+    }
+    std::cout << "👀 Watching USB devices via " << backendName() << " events\n";
+    callback = std::move(onEvent);
+
+    // The loop wakes us whenever the backend socket has data.
+    bool watched = loop.watch(fd(), EPOLLIN, [this](uint32_t) {
+        receive(callback);
+    });
+    if (!watched) return false;
+    backend->start();
+
+    // Scan only once the socket is live, so a device plugged meanwhile is seen by one or the other
+    if (!snapshotPath.empty()) {
+        DeviceIndex previous;
+        bool sameBoot = false;
+        bool havePrevious = previous.load(snapshotPath, sameBoot);
+        size_t reported = rescan(havePrevious ? &previous : nullptr, sameBoot);
+        if (havePrevious) {
+            std::cout << "🗂️ " << reported << " device(s) plugged while stopped (snapshot from "
+                      << (sameBoot ? "this" : "an earlier") << " boot)\n";
+        } else {
+            std::cout << "🗂️ No device snapshot yet, recording the current devices\n";
         }
+        known.save(snapshotPath);
     }
+    return true;
+}
+
+void UsbMonitor::receive(const Callback& onEvent) {
+    backend->receive([this, &onEvent](const UsbEvent& event) {
+        journal.append(event);
+
+        bool tracking = !snapshotPath.empty();
+        if (event.action == UsbAction::Remove && tracking) known.erase(event);
+
+        // Only trigger when a new USB device is added.
+        if (event.action != UsbAction::Add) return;
+        if (!tracking || admit(event)) onEvent(event);
+    });
+}
+
+bool UsbMonitor::journalEvents(const std::string& path, uint32_t capacity) {
+    return journal.open(path, capacity);
+}
+
+void UsbMonitor::trackDevices(std::string path) {
+    snapshotPath = std::move(path);
+}
+
+size_t UsbMonitor::reconcile() {
+    if (snapshotPath.empty() || !callback) return 0;
+    size_t reported = rescan(&known, true);
+    std::cout << "🗂️ " << reported << " device(s) plugged while asleep\n";
+    return reported;
+}
+
+bool UsbMonitor::saveSnapshot() {
+    if (snapshotPath.empty()) return false;
+    DeviceIndex current;
+    backend->enumerate([&current](const UsbEvent& event) { current.insert(event); });
+    return current.save(snapshotPath);
+}
+
+size_t UsbMonitor::rescan(const DeviceIndex* previous, bool sameBoot) {
+    // Collect first: the callback may be slow and the previous set may be `known` itself
+    std::vector<UsbEvent> devices;
+    auto start = std::chrono::steady_clock::now();
+    backend->enumerate([&devices](const UsbEvent& event) { devices.push_back(event); });
+
+    size_t reported = 0;
+    lastScan.clear();
+    for (const UsbEvent& event : devices) {
+        lastScan.insert(event);
+        if (previous && !previous->contains(event, sameBoot)) {
+            journal.append(event, JournalRecord::FLAG_SCANNED);
+            callback(event);
+            reported++;
+        }
+    }
+    for (const UsbEvent& event : devices) known.insert(event);
+    dedupeUntil = std::chrono::steady_clock::now() + std::chrono::milliseconds(MonitorConfig::RECONCILE_DEDUPE_MS);
+
+    std::cout << "🔎 Scanned " << devices.size() << " USB device(s) in "
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+              << " ms\n";
+    return reported;
+}
+
+bool UsbMonitor::admit(const UsbEvent& event) {
+    if (std::chrono::steady_clock::now() < dedupeUntil && lastScan.contains(event)) return false;
+    known.insert(event);
+    return true;
 }
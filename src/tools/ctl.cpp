@@ -0,0 +1,81 @@
+/**
+ * @file ctl.cpp
+ * @brief `usb_moaner-ctl`: sends one request to the daemon's control socket.
+ *
+ * The arguments form the request; the reply is printed and the exit status
+ * is 1 when the daemon answered with an error.
+ *
+ * ## Usage
+ * ```
+ * make tools
+ * ../bin/usb_moaner-ctl stats                 # counters and latency histograms
+ * ../bin/usb_moaner-ctl inject 046d:c534      # test alert, no device needed
+ * ../bin/usb_moaner-ctl mute 30               # no alerts for 30 minutes
+ * ../bin/usb_moaner-ctl unmute
+ * ../bin/usb_moaner-ctl reload                # like SIGHUP
+ * ```
+ * `USB_MOANER_SOCKET` overrides the socket path (default:
+ * `ControlConfig::getSocketPath()`).
+ */
+#include "../include/Config.hpp"
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+    constexpr int REPLY_TIMEOUT_SEC = 5;
+    constexpr size_t REPLY_CAPACITY = 64 * 1024;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " stats | inject vvvv:pppp [devpath] | mute <minutes> | unmute | reload\n";
+        return 2;
+    }
+
+    std::string request = argv[1];
+    for (int i = 2; i < argc; i++) request += std::string(" ") + argv[i];
+
+    const char* override = std::getenv("USB_MOANER_SOCKET");
+    std::string path = override && *override ? override : ControlConfig::getSocketPath();
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Socket path too long: " << path << "\n";
+        return 1;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    timeval timeout{REPLY_TIMEOUT_SEC, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "Cannot reach usb_moaner at " << path << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+
+    if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) < 0) {
+        std::cerr << "Send failed: " << strerror(errno) << "\n";
+        return 1;
+    }
+
+    std::string reply(REPLY_CAPACITY, '\0');
+    ssize_t len = recv(fd, reply.data(), reply.size(), 0);
+    close(fd);
+    if (len <= 0) {
+        std::cerr << "No reply: " << (len < 0 ? strerror(errno) : "connection closed") << "\n";
+        return 1;
+    }
+    reply.resize(static_cast<size_t>(len));
+
+    std::fwrite(reply.data(), 1, reply.size(), stdout);
+    if (reply.back() != '\n') std::fputc('\n', stdout);
+    return reply.compare(0, 5, "error") == 0 ? 1 : 0;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file journal.cpp
+ * @brief `usb_moaner-journal`: lists, filters and aggregates the USB event journal.
+ *
+ * Maps the `EventJournal` file read-only (the daemon may keep appending) and
+ * scans its fixed-width records in place, so even a full ring is queried in
+ * a few milliseconds.
+ *
+ * ## Usage
+ * ```
+ * make tools && ../bin/usb_moaner-journal --since 2h --device 046d
+ * ../bin/usb_moaner-journal --since "2026-10-01" --until "2026-10-02 12:00" --action remove
+ * ../bin/usb_moaner-journal --summary
+ * ```
+ * Options: `--file <path>` (default: `JournalConfig::getJournalPath()`),
+ * `--since <time>`, `--until <time>`, `--device <vid[:pid]>`,
+ * `--action <add|remove|bind|unbind|change>`, `--summary` (per-device
+ * counts instead of events), `--count` (number of matches only), `--help`.
+ *
+ * Times are local, `YYYY-MM-DD[ HH:MM[:SS]]`, `@<unix seconds>`, or a
+ * duration ago: `90s`, `15m`, `2h`, `7d`.
+ */
+#include "../include/EventJournal.hpp"
+#include "../include/Config.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr uint64_t NS_PER_SEC = 1000000000ull;
+
+    struct Query {
+        std::string file = JournalConfig::getJournalPath();
+        uint64_t sinceNs = 0;
+        uint64_t untilNs = UINT64_MAX;
+        bool anyVendor = true, anyProduct = true;
+        uint16_t vendor = 0, product = 0;
+        bool anyAction = true;
+        UsbAction action = UsbAction::Unknown;
+        bool summary = false;
+        bool countOnly = false;
+        bool help = false;
+
+        bool matches(const JournalRecord& r) const {
+            return r.timeNs >= sinceNs && r.timeNs < untilNs &&
+                   (anyVendor || r.vendor == vendor) && (anyProduct || r.product == product) &&
+                   (anyAction || r.action == static_cast<uint8_t>(action));
+        }
+    };
+
+    /// Per-device aggregate for `--summary`.
+    struct DeviceStats {
+        uint16_t vendor = 0, product = 0;
+        uint64_t adds = 0, removes = 0, others = 0;
+        uint64_t firstNs = UINT64_MAX, lastNs = 0;
+    };
+
+    bool parseTime(const char* text, uint64_t& ns) {
+        uint64_t now = static_cast<uint64_t>(std::time(nullptr)) * NS_PER_SEC;
+        char* end = nullptr;
+
+        if (text[0] == '@') {
+            unsigned long long sec = std::strtoull(text + 1, &end, 10);
+            if (end == text + 1 || *end) return false;
+            ns = sec * NS_PER_SEC;
+            return true;
+        }
+
+        // Relative: a count followed by a unit
+        unsigned long long amount = std::strtoull(text, &end, 10);
+        if (end != text && end[0] && !end[1]) {
+            uint64_t unit = 0;
+            switch (end[0]) {
+                case 's': unit = 1; break;
+                case 'm': unit = 60; break;
+                case 'h': unit = 3600; break;
+                case 'd': unit = 86400; break;
+                default: return false;
+            }
+            uint64_t ago = amount * unit * NS_PER_SEC;
+            ns = ago < now ? now - ago : 0;
+            return true;
+        }
+
+        for (const char* format : {"%Y-%m-%d %H:%M:%S", "%Y-%m-%d %H:%M", "%Y-%m-%d"}) {
+            std::tm tm{};
+            const char* rest = strptime(text, format, &tm);
+            if (!rest || *rest) continue;
+            tm.tm_isdst = -1;
+            std::time_t sec = std::mktime(&tm);
+            if (sec < 0) return false;
+            ns = static_cast<uint64_t>(sec) * NS_PER_SEC;
+            return true;
+        }
+        return false;
+    }
+
+    bool parseDevice(const char* text, Query& query) {
+        std::string_view spec(text);
+        size_t colon = spec.find(':');
+        if (!UsbEvent::parseHex(spec.substr(0, colon), query.vendor)) return false;
+        query.anyVendor = false;
+        if (colon == std::string_view::npos) return true;
+        std::string_view pid = spec.substr(colon + 1);
+        if (pid == "*") return true;
+        query.anyProduct = false;
+        return UsbEvent::parseHex(pid, query.product);
+    }
+
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " [--file <path>] [--since <time>] [--until <time>]\n"
+                  << "       [--device <vid[:pid]>] [--action <add|remove|bind|unbind|change>] [--summary | --count]\n"
+                  << "Times: YYYY-MM-DD[ HH:MM[:SS]], @<unix seconds>, or ago: 90s, 15m, 2h, 7d\n";
+    }
+
+    bool parseOptions(int argc, char** argv, Query& query) {
+        for (int i = 1; i < argc; i++) {
+            std::string key = argv[i];
+            if (key == "--help" || key == "-h") { query.help = true; return true; }
+            if (key == "--summary") { query.summary = true; continue; }
+            if (key == "--count") { query.countOnly = true; continue; }
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << key << "\n";
+                return false;
+            }
+            const char* value = argv[++i];
+            bool ok = true;
+            if (key == "--file") query.file = value;
+            else if (key == "--since") ok = parseTime(value, query.sinceNs);
+            else if (key == "--until") ok = parseTime(value, query.untilNs);
+            else if (key == "--device") ok = parseDevice(value, query);
+            else if (key == "--action") {
+                query.action = UsbEvent::parseAction(value);
+                query.anyAction = false;
+                ok = query.action != UsbAction::Unknown;
+            } else {
+                std::cerr << "Unknown option: " << key << "\n";
+                return false;
+            }
+            if (!ok) {
+                std::cerr << "Bad value for " << key << ": " << value << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// "YYYY-MM-DD HH:MM:SS.mmm" in local time.
+    void formatTime(uint64_t ns, char* buf, size_t size) {
+        std::time_t sec = static_cast<std::time_t>(ns / NS_PER_SEC);
+        std::tm tm{};
+        localtime_r(&sec, &tm);
+        size_t len = std::strftime(buf, size, "%Y-%m-%d %H:%M:%S", &tm);
+        std::snprintf(buf + len, size - len, ".%03u", static_cast<unsigned>(ns % NS_PER_SEC / 1000000));
+    }
+
+    void printRecord(const JournalRecord& r) {
+        char when[40];
+        formatTime(r.timeNs, when, sizeof(when));
+        std::printf("%s  %-6s  %04x:%04x  %03u/%03u  %016llx%s\n", when,
+                    UsbEvent::actionName(static_cast<UsbAction>(r.action)), r.vendor, r.product,
+                    r.busnum, r.devnum, static_cast<unsigned long long>(r.devpathHash),
+                    (r.flags & JournalRecord::FLAG_SCANNED) ? "  (scan)" : "");
+    }
+
+    void printSummary(const std::unordered_map<uint32_t, DeviceStats>& devices) {
+        std::vector<DeviceStats> rows;
+        rows.reserve(devices.size());
+        for (const auto& entry : devices) rows.push_back(entry.second);
+        std::sort(rows.begin(), rows.end(), [](const DeviceStats& a, const DeviceStats& b) {
+            return a.adds + a.removes + a.others > b.adds + b.removes + b.others;
+        });
+
+        std::printf("%-9s  %8s  %8s  %8s  %-23s  %-23s\n", "device", "add", "remove", "other", "first", "last");
+        for (const DeviceStats& d : rows) {
+            char first[40], last[40];
+            formatTime(d.firstNs, first, sizeof(first));
+            formatTime(d.lastNs, last, sizeof(last));
+            std::printf("%04x:%04x  %8llu  %8llu  %8llu  %s  %s\n", d.vendor, d.product,
+                        static_cast<unsigned long long>(d.adds), static_cast<unsigned long long>(d.removes),
+                        static_cast<unsigned long long>(d.others), first, last);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Query query;
+    if (!parseOptions(argc, argv, query)) return 2;
+    if (query.help) {
+        printUsage(argv[0]);
+        return 0;
+    }
+
+    JournalView view;
+    if (!view.open(query.file)) {
+        std::cerr << "No event journal at " << query.file << "\n";
+        return 1;
+    }
+
+    uint64_t matched = 0;
+    std::unordered_map<uint32_t, DeviceStats> devices;
+    uint64_t retained = view.scan([&](const JournalRecord& r) {
+        if (!query.matches(r)) return;
+        matched++;
+        if (query.countOnly) return;
+        if (!query.summary) {
+            printRecord(r);
+            return;
+        }
+        DeviceStats& d = devices[static_cast<uint32_t>(r.vendor) << 16 | r.product];
+        d.vendor = r.vendor;
+        d.product = r.product;
+        if (r.action == static_cast<uint8_t>(UsbAction::Add)) d.adds++;
+        else if (r.action == static_cast<uint8_t>(UsbAction::Remove)) d.removes++;
+        else d.others++;
+        d.firstNs = std::min(d.firstNs, r.timeNs);
+        d.lastNs = std::max(d.lastNs, r.timeNs);
+    });
+
+    if (query.summary) printSummary(devices);
+    if (query.countOnly) std::printf("%llu\n", static_cast<unsigned long long>(matched));
+    else
+        std::fprintf(stderr, "%llu of %llu retained events matched (%llu ever written, %u slots)\n",
+                     static_cast<unsigned long long>(matched), static_cast<unsigned long long>(retained),
+                     static_cast<unsigned long long>(view.written()), view.capacity());
+    return 0;
+}